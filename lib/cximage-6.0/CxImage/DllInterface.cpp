@@ -409,10 +409,15 @@ extern "C"
     CxImage image(dwImageType);
     try
     {
-      bool success = image.Decode(buffer, size, dwImageType);
+      // decode jpegs straight to (roughly) the thumb size rather than at full resolution
+      int actualwidth = maxWidth * maxHeight;
+      int actualheight = 0;
+      bool success = image.Decode(buffer, size, dwImageType, actualwidth, actualheight);
       if (!success && dwImageType != CXIMAGE_FORMAT_UNKNOWN)
       { // try to decode with unknown imagetype
-        success = image.Decode(buffer, size, CXIMAGE_FORMAT_UNKNOWN);
+        actualwidth = maxWidth * maxHeight;
+        actualheight = 0;
+        success = image.Decode(buffer, size, CXIMAGE_FORMAT_UNKNOWN, actualwidth, actualheight);
       }
       if (!success || !image.IsValid())
       {
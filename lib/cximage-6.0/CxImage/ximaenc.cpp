@@ -700,6 +700,20 @@ bool CxImage::Decode(BYTE * buffer, DWORD size, DWORD imagetype)
 	CxMemFile file(buffer,size);
 	return Decode(&file,imagetype);
 }
+#ifdef XBMC
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * Loads an image from memory buffer, downscaling on decode where the format
+ * supports it (JPEG DCT scaling by 1/2, 1/4 or 1/8).
+ * \param iWidth, iHeight: maximal size to decode to (or area in iWidth with
+ *        iHeight set to 0), on return the size of the original image.
+ */
+bool CxImage::Decode(BYTE * buffer, DWORD size, DWORD imagetype, int &iWidth, int &iHeight)
+{
+	CxMemFile file(buffer,size);
+	return Decode(&file,imagetype,iWidth,iHeight);
+}
+#endif
 ////////////////////////////////////////////////////////////////////////////////
 /**
  * Loads an image from file handle.
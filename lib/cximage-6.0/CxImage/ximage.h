@@ -538,6 +538,7 @@ public:
 		int iHeight=0;
 		return Decode(hFile, imagetype, iWidth, iHeight);
 	};
+	bool Decode(BYTE * buffer, DWORD size, DWORD imagetype, int &iWidth, int &iHeight);
 #else
 	bool Load(const char * filename, DWORD imagetype);
 	bool Decode(FILE * hFile, DWORD imagetype);
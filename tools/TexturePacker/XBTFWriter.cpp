@@ -61,9 +61,49 @@ bool CXBTFWriter::Close()
 
   fwrite(m_data, 1, m_size, m_file);
 
+  bool ret = WriteIndex();
+
   Cleanup();
 
-  return true;
+  return ret;
+}
+
+bool CXBTFWriter::WriteIndex()
+{
+  std::vector<CXBTFFile>& files = m_xbtf.GetFiles();
+
+  // keep the load factor at 50% or below so lookups rarely probe
+  uint32_t slots = 16;
+  while (slots < files.size() * 2)
+    slots <<= 1;
+
+  std::vector<uint32_t> hashes(slots, 0);
+  std::vector<uint32_t> offsets(slots, 0);
+
+  uint64_t offset = 4 /* Magic */ + 1 /* Version */ + sizeof(uint32_t) /* Number of Files */;
+  for (size_t i = 0; i < files.size(); i++)
+  {
+    uint32_t hash = CXBTF::HashPath(files[i].GetPath());
+    uint32_t slot = hash & (slots - 1);
+    while (offsets[slot])
+      slot = (slot + 1) & (slots - 1);
+
+    hashes[slot] = hash;
+    offsets[slot] = (uint32_t)offset;
+    offset += files[i].GetHeaderSize();
+  }
+
+  uint64_t indexOffset = ftell(m_file);
+  WRITE_U32(slots, m_file);
+  for (uint32_t i = 0; i < slots; i++)
+  {
+    WRITE_U32(hashes[i], m_file);
+    WRITE_U32(offsets[i], m_file);
+  }
+  WRITE_U64(indexOffset, m_file);
+  WRITE_STR(XBTF_INDEX_MAGIC, 4, m_file);
+
+  return ferror(m_file) == 0;
 }
 
 void CXBTFWriter::Cleanup()
@@ -39,6 +39,7 @@ public:
 
 private:
   void Cleanup();
+  bool WriteIndex();
 
   CXBTF& m_xbtf;
   std::string m_outputFile;
@@ -2114,9 +2114,10 @@ void CApplication::Render()
     lastFrameTime = CTimeUtils::GetTimeMS();
   }
 
-  CSingleLock lock(g_graphicsContext);
+  CRenderThreadLock lock;
   CTimeUtils::UpdateFrameTime();
   g_infoManager.UpdateFPS();
+  g_graphicsContext.UpdateLockWait();
 
   int vsync_mode = g_guiSettings.GetInt("videoscreen.vsync");
   if (g_graphicsContext.IsFullScreenVideo() && IsPlaying() && vsync_mode == VSYNC_VIDEO)
@@ -2715,16 +2716,17 @@ void CApplication::FrameMove()
   // never set a frametime less than 2 fps to avoid problems when debuggin and on breaks
   if( frameTime > 0.5 ) frameTime = 0.5;
 
-  g_graphicsContext.Lock();
-  // check if there are notifications to display
-  if (m_guiDialogKaiToast.DoWork())
   {
-    if (!m_guiDialogKaiToast.IsDialogRunning())
+    CRenderThreadLock lock;
+    // check if there are notifications to display
+    if (m_guiDialogKaiToast.DoWork())
     {
-      m_guiDialogKaiToast.Show();
+      if (!m_guiDialogKaiToast.IsDialogRunning())
+      {
+        m_guiDialogKaiToast.Show();
+      }
     }
   }
-  g_graphicsContext.Unlock();
 
   UpdateLCD();
 
@@ -3337,6 +3339,7 @@ void CApplication::Stop(int exitCode)
 
     StopPVRManager();
     StopServices();
+    CAnnouncementManager::Deinitialize();
     //Sleep(5000);
 
 #if defined(__APPLE__) && !defined(__arm__)
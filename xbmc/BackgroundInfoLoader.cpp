@@ -24,6 +24,9 @@
 #include "settings/AdvancedSettings.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+#include <algorithm>
 
 using namespace std;
 
@@ -38,6 +41,11 @@ CBackgroundInfoLoader::CBackgroundInfoLoader(int nThreads)
   m_nRequestedThreads = nThreads;
   m_bStartCalled = false;
   m_nActiveThreads = 0;
+  m_nextItem = 0;
+  m_visibleStart = 0;
+  m_visibleCount = 0;
+  m_visibleTotal = 0;
+  m_visibleMax = 0;
 }
 
 CBackgroundInfoLoader::~CBackgroundInfoLoader()
@@ -69,11 +77,17 @@ void CBackgroundInfoLoader::Run()
       {
         CSingleLock lock(m_lock);
         CFileItemPtr pItem;
-        vector<CFileItemPtr>::iterator iter = m_vecItems.begin();
-        if (iter != m_vecItems.end())
+        while (!pItem && !m_priority.empty())
+        { // items near the screen first
+          if (m_pending.erase(m_priority.back().get()))
+            pItem = m_priority.back();
+          m_priority.pop_back();
+        }
+        while (!pItem && m_nextItem < m_vecItems.size())
         {
-          pItem = *iter;
-          m_vecItems.erase(iter);
+          if (m_pending.erase(m_vecItems[m_nextItem].get()))
+            pItem = m_vecItems[m_nextItem];
+          m_nextItem++;
         }
 
         if (pItem == NULL)
@@ -83,6 +97,7 @@ void CBackgroundInfoLoader::Run()
         if ((m_pProgressCallback && m_pProgressCallback->Abort()) || m_bStop)
           break;
 
+        m_loading.insert(pItem.get());
         lock.Leave();
         try
         {
@@ -93,6 +108,15 @@ void CBackgroundInfoLoader::Run()
         {
           CLog::Log(LOGERROR, "%s::LoadItem - Unhandled exception for item %s", __FUNCTION__, pItem->m_strPath.c_str());
         }
+        lock.Enter();
+        m_loading.erase(pItem.get());
+        if (m_visible.erase(pItem.get()) && m_visible.empty())
+        {
+          unsigned int elapsed = CTimeUtils::GetTimeMS() - m_visibleStart;
+          m_visibleCount++;
+          m_visibleTotal += elapsed;
+          m_visibleMax = std::max(m_visibleMax, elapsed);
+        }
       }
     }
 
@@ -119,9 +143,15 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
   EnterCriticalSection(m_lock);
 
   for (int nItem=0; nItem < items.Size(); nItem++)
+  {
     m_vecItems.push_back(items[nItem]);
+    m_pending.insert(items[nItem].get());
+  }
+  m_nextItem = 0;
 
   m_pVecItems = &items;
+  m_providerLink = items.GetProviderLink();
+  m_providerLink->Set(this);
   m_bStop = false;
   m_bStartCalled = false;
 
@@ -164,11 +194,46 @@ void CBackgroundInfoLoader::StopThread()
   }
 
   m_workers.clear();
+
+  CSingleLock lock(m_lock);
+  if (m_visibleCount)
+    CLog::Log(LOGDEBUG, "%s - items on screen loaded %u times, in %u ms on average, %u ms at most", __FUNCTION__, m_visibleCount, m_visibleTotal / m_visibleCount, m_visibleMax);
+  m_visibleCount = m_visibleTotal = m_visibleMax = 0;
+  m_visible.clear();
+
+  if (m_providerLink && m_providerLink->Get() == this)
+    m_providerLink->Set(NULL);
+  m_providerLink.reset();
   m_vecItems.clear();
+  m_priority.clear();
+  m_pending.clear();
+  m_loading.clear();
+  m_nextItem = 0;
   m_pVecItems = NULL;
   m_nActiveThreads = 0;
 }
 
+void CBackgroundInfoLoader::FetchItems(const vector<CGUIListItemPtr> &items, unsigned int visible)
+{
+  CSingleLock lock(m_lock);
+  // the newest request replaces the last one, so items that have scrolled away
+  // drop back to list order
+  m_priority.clear();
+  m_visible.clear();
+  for (int i = (int)items.size() - 1; i >= 0; i--)
+  {
+    if (!items[i]->IsFileItem())
+      continue;
+    CFileItem *item = static_cast<CFileItem *>(items[i].get());
+    bool pending = m_pending.find(item) != m_pending.end();
+    if (pending)
+      m_priority.push_back(boost::static_pointer_cast<CFileItem>(items[i]));
+    if (i < (int)visible && (pending || m_loading.find(item) != m_loading.end()))
+      m_visible.insert(item);
+  }
+  m_visibleStart = CTimeUtils::GetTimeMS();
+}
+
 bool CBackgroundInfoLoader::IsLoading()
 {
   return m_nActiveThreads > 0;
@@ -24,7 +24,9 @@
 #include "threads/Thread.h"
 #include "IProgressCallback.h"
 #include "threads/CriticalSection.h"
+#include "guilib/IListItemProvider.h"
 
+#include <set>
 #include <vector>
 #include "boost/shared_ptr.hpp"
 
@@ -38,7 +40,12 @@ public:
   virtual void OnItemLoaded(CFileItem* pItem) = 0;
 };
 
-class CBackgroundInfoLoader : public IRunnable
+/*! \brief Loads extra info for each item of a list on worker threads.
+
+ While loading it is the provider of the list, so items that containers bring
+ on screen are loaded ahead of the rest.
+ */
+class CBackgroundInfoLoader : public IRunnable, public IListItemProvider
 {
 public:
   CBackgroundInfoLoader(int nThreads=-1);
@@ -50,6 +57,7 @@ public:
   void SetObserver(IBackgroundLoaderObserver* pObserver);
   void SetProgressCallback(IProgressCallback* pCallback);
   virtual bool LoadItem(CFileItem* pItem) { return false; };
+  virtual void FetchItems(const std::vector<CGUIListItemPtr> &items, unsigned int visible);
 
   void StopThread(); // will actually stop all worker threads.
   void StopAsync();  // will ask loader to stop as soon as possible, but not block
@@ -62,6 +70,18 @@ protected:
 
   CFileItemList *m_pVecItems;
   std::vector<CFileItemPtr> m_vecItems; // FileItemList would delete the items and we only want to keep a reference.
+  unsigned int m_nextItem;               // next item of m_vecItems to load in list order
+  std::vector<CFileItemPtr> m_priority;  // items asked for by a container, the last one is loaded first
+  std::set<CFileItem*> m_pending;        // items not yet handed to a worker
+  std::set<CFileItem*> m_loading;        // items a worker is loading
+  CListItemProviderLinkPtr m_providerLink;
+
+  // time from a container asking for the items on screen until they are all loaded
+  std::set<CFileItem*> m_visible;
+  unsigned int m_visibleStart;
+  unsigned int m_visibleCount;
+  unsigned int m_visibleTotal;
+  unsigned int m_visibleMax;
   CCriticalSection m_lock;
 
   bool m_bStartCalled;
@@ -61,6 +61,9 @@
 #include "utils/log.h"
 #include "utils/Variant.h"
 #include "music/karaoke/karaokelyricsfactory.h"
+#include "threads/Thread.h"
+#include "utils/CPUInfo.h"
+#include "utils/TimeUtils.h"
 
 using namespace std;
 using namespace XFILE;
@@ -69,6 +72,9 @@ using namespace MUSIC_INFO;
 using namespace PVR;
 using namespace EPG;
 
+// lists at least this long are sorted in parallel on multicore systems
+#define PARALLEL_SORT_MIN_ITEMS 10000
+
 CFileItem::CFileItem(const CSong& song)
 {
   m_musicInfoTag = NULL;
@@ -1510,6 +1516,7 @@ CFileItemList::CFileItemList()
   m_sortOrder=SORT_ORDER_NONE;
   m_sortIgnoreFolders = false;
   m_replaceListing = false;
+  m_providerLink.reset(new CListItemProviderLink);
 }
 
 CFileItemList::CFileItemList(const CStdString& strPath)
@@ -1522,6 +1529,7 @@ CFileItemList::CFileItemList(const CStdString& strPath)
   m_sortOrder=SORT_ORDER_NONE;
   m_sortIgnoreFolders = false;
   m_replaceListing = false;
+  m_providerLink.reset(new CListItemProviderLink);
 }
 
 CFileItemList::~CFileItemList()
@@ -1814,16 +1822,85 @@ void CFileItemList::Reserve(int iCount)
   m_items.reserve(iCount);
 }
 
+class CFileItemSortRange : public IRunnable
+{
+public:
+  CFileItemSortRange(VECFILEITEMS::iterator begin, VECFILEITEMS::iterator end, FILEITEMLISTCOMPARISONFUNC func)
+    : m_begin(begin), m_end(end), m_func(func) {}
+
+  virtual void Run()
+  {
+    std::stable_sort(m_begin, m_end, m_func);
+  }
+
+private:
+  VECFILEITEMS::iterator     m_begin;
+  VECFILEITEMS::iterator     m_end;
+  FILEITEMLISTCOMPARISONFUNC m_func;
+};
+
 void CFileItemList::Sort(FILEITEMLISTCOMPARISONFUNC func)
 {
   CSingleLock lock(m_lock);
-  std::stable_sort(m_items.begin(), m_items.end(), func);
+  unsigned int ranges = std::min(g_cpuInfo.getCPUCount(), 8);
+  if (m_items.size() < PARALLEL_SORT_MIN_ITEMS || ranges < 2)
+  {
+    std::stable_sort(m_items.begin(), m_items.end(), func);
+    return;
+  }
+
+  unsigned int start = CTimeUtils::GetTimeMS();
+
+  // sort one range per cpu, the first one on this thread, then merge them.
+  // the comparison functions only read the items, and merging keeps the sort stable
+  std::vector<VECFILEITEMS::iterator> bounds;
+  for (unsigned int i = 0; i < ranges; i++)
+    bounds.push_back(m_items.begin() + m_items.size() * i / ranges);
+  bounds.push_back(m_items.end());
+
+  std::vector<CFileItemSortRange*> jobs;
+  std::vector<CThread*> threads;
+  for (unsigned int i = 1; i < ranges; i++)
+  {
+    jobs.push_back(new CFileItemSortRange(bounds[i], bounds[i + 1], func));
+    threads.push_back(new CThread(jobs.back(), "CFileItemList::Sort"));
+    threads.back()->Create();
+  }
+
+  std::stable_sort(bounds[0], bounds[1], func);
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    threads[i]->StopThread();
+    delete threads[i];
+    delete jobs[i];
+  }
+
+  for (unsigned int i = 2; i <= ranges; i++)
+    std::inplace_merge(bounds[0], bounds[i - 1], bounds[i], func);
+
+  CLog::Log(LOGDEBUG, "%s - sorted %u items in %u ranges, took %u ms", __FUNCTION__, (unsigned int)m_items.size(), ranges, CTimeUtils::GetTimeMS() - start);
 }
 
-void CFileItemList::FillSortFields(FILEITEMFILLFUNC func)
+void CFileItemList::FillSortKeys(FILEITEMFILLFUNC func, SORT_METHOD sortMethod)
 {
   CSingleLock lock(m_lock);
-  std::for_each(m_items.begin(), m_items.end(), func);
+  // keys built from the label survive changes of the sort order and of other
+  // lists sharing the item, as changing the label drops them. Sort labels filled
+  // from the tags (play count, rating, ...) may be stale once a tag changes
+  bool reuse = sortMethod == SORT_METHOD_LABEL ||
+               sortMethod == SORT_METHOD_LABEL_IGNORE_FOLDERS ||
+               sortMethod == SORT_METHOD_LABEL_IGNORE_THE;
+  std::string key;
+  for (unsigned int i = 0; i < m_items.size(); i++)
+  {
+    CFileItemPtr &item = m_items[i];
+    if (!item || (reuse && item->HasSortKey(sortMethod)))
+      continue;
+    func(item);
+    StringUtils::AlphaNumericSortKey(item->GetSortLabel().c_str(), key);
+    item->SetSortKey(key, sortMethod);
+  }
 }
 
 void CFileItemList::Sort(SORT_METHOD sortMethod, SORT_ORDER sortOrder)
@@ -1832,122 +1909,126 @@ void CFileItemList::Sort(SORT_METHOD sortMethod, SORT_ORDER sortOrder)
   if (sortMethod==m_sortMethod && m_sortOrder==sortOrder)
     return;
 
+  FILEITEMFILLFUNC fill = NULL;
   switch (sortMethod)
   {
   case SORT_METHOD_LABEL:
   case SORT_METHOD_LABEL_IGNORE_FOLDERS:
-    FillSortFields(SSortFileItem::ByLabel);
+    fill = SSortFileItem::ByLabel;
     break;
   case SORT_METHOD_LABEL_IGNORE_THE:
-    FillSortFields(SSortFileItem::ByLabelNoThe);
+    fill = SSortFileItem::ByLabelNoThe;
     break;
   case SORT_METHOD_DATE:
-    FillSortFields(SSortFileItem::ByDate);
+    fill = SSortFileItem::ByDate;
     break;
   case SORT_METHOD_SIZE:
-    FillSortFields(SSortFileItem::BySize);
+    fill = SSortFileItem::BySize;
     break;
   case SORT_METHOD_BITRATE:
-    FillSortFields(SSortFileItem::ByBitrate);
+    fill = SSortFileItem::ByBitrate;
     break;      
   case SORT_METHOD_DRIVE_TYPE:
-    FillSortFields(SSortFileItem::ByDriveType);
+    fill = SSortFileItem::ByDriveType;
     break;
   case SORT_METHOD_TRACKNUM:
-    FillSortFields(SSortFileItem::BySongTrackNum);
+    fill = SSortFileItem::BySongTrackNum;
     break;
   case SORT_METHOD_EPISODE:
-    FillSortFields(SSortFileItem::ByEpisodeNum);
+    fill = SSortFileItem::ByEpisodeNum;
     break;
   case SORT_METHOD_DURATION:
-    FillSortFields(SSortFileItem::BySongDuration);
+    fill = SSortFileItem::BySongDuration;
     break;
   case SORT_METHOD_TITLE_IGNORE_THE:
-    FillSortFields(SSortFileItem::BySongTitleNoThe);
+    fill = SSortFileItem::BySongTitleNoThe;
     break;
   case SORT_METHOD_TITLE:
-    FillSortFields(SSortFileItem::BySongTitle);
+    fill = SSortFileItem::BySongTitle;
     break;
   case SORT_METHOD_ARTIST:
-    FillSortFields(SSortFileItem::BySongArtist);
+    fill = SSortFileItem::BySongArtist;
     break;
   case SORT_METHOD_ARTIST_IGNORE_THE:
-    FillSortFields(SSortFileItem::BySongArtistNoThe);
+    fill = SSortFileItem::BySongArtistNoThe;
     break;
   case SORT_METHOD_ALBUM:
-    FillSortFields(SSortFileItem::BySongAlbum);
+    fill = SSortFileItem::BySongAlbum;
     break;
   case SORT_METHOD_ALBUM_IGNORE_THE:
-    FillSortFields(SSortFileItem::BySongAlbumNoThe);
+    fill = SSortFileItem::BySongAlbumNoThe;
     break;
   case SORT_METHOD_GENRE:
-    FillSortFields(SSortFileItem::ByGenre);
+    fill = SSortFileItem::ByGenre;
     break;
   case SORT_METHOD_COUNTRY:
-    FillSortFields(SSortFileItem::ByCountry);
+    fill = SSortFileItem::ByCountry;
     break;
   case SORT_METHOD_DATEADDED:
-    FillSortFields(SSortFileItem::ByDateAdded);
+    fill = SSortFileItem::ByDateAdded;
     break;
   case SORT_METHOD_FILE:
-    FillSortFields(SSortFileItem::ByFile);
+    fill = SSortFileItem::ByFile;
     break;
   case SORT_METHOD_VIDEO_RATING:
-    FillSortFields(SSortFileItem::ByMovieRating);
+    fill = SSortFileItem::ByMovieRating;
     break;
   case SORT_METHOD_VIDEO_TITLE:
-    FillSortFields(SSortFileItem::ByMovieTitle);
+    fill = SSortFileItem::ByMovieTitle;
     break;
   case SORT_METHOD_VIDEO_SORT_TITLE:
-    FillSortFields(SSortFileItem::ByMovieSortTitle);
+    fill = SSortFileItem::ByMovieSortTitle;
     break;
   case SORT_METHOD_VIDEO_SORT_TITLE_IGNORE_THE:
-    FillSortFields(SSortFileItem::ByMovieSortTitleNoThe);
+    fill = SSortFileItem::ByMovieSortTitleNoThe;
     break;
   case SORT_METHOD_YEAR:
-    FillSortFields(SSortFileItem::ByYear);
+    fill = SSortFileItem::ByYear;
     break;
   case SORT_METHOD_PRODUCTIONCODE:
-    FillSortFields(SSortFileItem::ByProductionCode);
+    fill = SSortFileItem::ByProductionCode;
     break;
   case SORT_METHOD_PROGRAM_COUNT:
   case SORT_METHOD_PLAYLIST_ORDER:
     // TODO: Playlist order is hacked into program count variable (not nice, but ok until 2.0)
-    FillSortFields(SSortFileItem::ByProgramCount);
+    fill = SSortFileItem::ByProgramCount;
     break;
   case SORT_METHOD_SONG_RATING:
-    FillSortFields(SSortFileItem::BySongRating);
+    fill = SSortFileItem::BySongRating;
     break;
   case SORT_METHOD_MPAA_RATING:
-    FillSortFields(SSortFileItem::ByMPAARating);
+    fill = SSortFileItem::ByMPAARating;
     break;
   case SORT_METHOD_VIDEO_RUNTIME:
-    FillSortFields(SSortFileItem::ByMovieRuntime);
+    fill = SSortFileItem::ByMovieRuntime;
     break;
   case SORT_METHOD_STUDIO:
-    FillSortFields(SSortFileItem::ByStudio);
+    fill = SSortFileItem::ByStudio;
     break;
   case SORT_METHOD_STUDIO_IGNORE_THE:
-    FillSortFields(SSortFileItem::ByStudioNoThe);
+    fill = SSortFileItem::ByStudioNoThe;
     break;
   case SORT_METHOD_FULLPATH:
-    FillSortFields(SSortFileItem::ByFullPath);
+    fill = SSortFileItem::ByFullPath;
     break;
   case SORT_METHOD_LASTPLAYED:
-    FillSortFields(SSortFileItem::ByLastPlayed);
+    fill = SSortFileItem::ByLastPlayed;
     break;
   case SORT_METHOD_PLAYCOUNT:
-    FillSortFields(SSortFileItem::ByPlayCount);
+    fill = SSortFileItem::ByPlayCount;
     break;
   case SORT_METHOD_LISTENERS:
-    FillSortFields(SSortFileItem::ByListeners);
+    fill = SSortFileItem::ByListeners;
     break;    
   case SORT_METHOD_CHANNEL:
-    FillSortFields(SSortFileItem::ByChannel);
+    fill = SSortFileItem::ByChannel;
     break;
   default:
     break;
   }
+  if (fill)
+    FillSortKeys(fill, sortMethod);
+
   if (sortMethod == SORT_METHOD_FILE        ||
       sortMethod == SORT_METHOD_VIDEO_SORT_TITLE ||
       sortMethod == SORT_METHOD_VIDEO_SORT_TITLE_IGNORE_THE ||
@@ -3308,8 +3389,14 @@ void CFileItemList::SetReplaceListing(bool replace)
 
 void CFileItemList::ClearSortState()
 {
+  CSingleLock lock(m_lock);
   m_sortMethod=SORT_METHOD_NONE;
   m_sortOrder=SORT_ORDER_NONE;
+  for (unsigned int i = 0; i < m_items.size(); i++)
+  {
+    if (m_items[i])
+      m_items[i]->ClearSortKey();
+  }
 }
 
 CVideoInfoTag* CFileItem::GetVideoInfoTag()
@@ -26,6 +26,7 @@
  */
 
 #include "guilib/GUIListItem.h"
+#include "guilib/IListItemProvider.h"
 #include "utils/Archive.h"
 #include "utils/ISerializable.h"
 #include "XBDateTime.h"
@@ -536,10 +537,18 @@ public:
   void SetContent(const CStdString &content) { m_content = content; };
   const CStdString &GetContent() const { return m_content; };
 
+  /*! \brief Link to the provider that fills in these items as they come on screen.
+   Containers bound to the list hold on to the link, so it is not passed on by Copy() or Assign().
+   */
+  const CListItemProviderLinkPtr &GetProviderLink() const { return m_providerLink; };
+
   void ClearSortState();
 private:
   void Sort(FILEITEMLISTCOMPARISONFUNC func);
-  void FillSortFields(FILEITEMFILLFUNC func);
+  /*! \brief Fill the sort labels and build their sort keys. When sorting by label,
+   items that still have keys from an earlier sort by the same method are skipped.
+   */
+  void FillSortKeys(FILEITEMFILLFUNC func, SORT_METHOD sortMethod);
   CStdString GetDiscCacheFile(int windowID) const;
 
   VECFILEITEMS m_items;
@@ -551,6 +560,7 @@ private:
   CACHE_TYPE m_cacheToDisc;
   bool m_replaceListing;
   CStdString m_content;
+  CListItemProviderLinkPtr m_providerLink;
 
   std::vector<SORT_METHOD_DETAILS> m_sortDetails;
 
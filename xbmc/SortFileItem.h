@@ -33,7 +33,7 @@ struct SSortFileItem
    */
   static CStdString RemoveArticles(const CStdString &label);
 
-  // Sort by sort field
+  // Sort by sort key, see CGUIListItem::GetSortKey
   static bool Ascending(const CFileItemPtr &left, const CFileItemPtr &right);
   static bool Descending(const CFileItemPtr &left, const CFileItemPtr &right);
   static bool IgnoreFoldersAscending(const CFileItemPtr &left, const CFileItemPtr &right);
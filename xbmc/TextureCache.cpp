@@ -21,11 +21,15 @@
 
 #include "TextureCache.h"
 #include "filesystem/File.h"
+#include "FileItem.h"
+#include "Util.h"
 #include "threads/SingleLock.h"
 #include "utils/Crc32.h"
 #include "settings/Settings.h"
 #include "settings/AdvancedSettings.h"
 #include "utils/log.h"
+#include "utils/CPUInfo.h"
+#include "utils/TimeUtils.h"
 
 #include "guilib/Texture.h"
 #include "guilib/DDSImage.h"
@@ -114,11 +118,74 @@ bool CTextureCache::CDDSJob::DoWork()
   { // convert to DDS
     CDDSImage dds;
     CLog::Log(LOGDEBUG, "Creating DDS version of: %s", m_original.c_str());
-    return dds.Create(URIUtils::ReplaceExtension(m_original, ".dds"), texture.GetWidth(), texture.GetHeight(), texture.GetPitch(), texture.GetPixels(), 40);
+    unsigned int threads = g_advancedSettings.m_ddsThreads ? g_advancedSettings.m_ddsThreads : g_cpuInfo.getCPUCount();
+    return dds.Create(URIUtils::ReplaceExtension(m_original, ".dds"), texture.GetWidth(), texture.GetHeight(), texture.GetPitch(), texture.GetPixels(), 40,
+                      threads, g_advancedSettings.m_ddsFastCompression);
   }
   return false;
 }
 
+CTextureCache::CDDSBatchJob::CDDSBatchJob(const CStdString &path)
+{
+  m_path = path;
+}
+
+bool CTextureCache::CDDSBatchJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(),GetType()) == 0)
+  {
+    const CDDSBatchJob* batchJob = dynamic_cast<const CDDSBatchJob*>(job);
+    if (batchJob && batchJob->m_path == m_path)
+      return true;
+  }
+  return false;
+}
+
+bool CTextureCache::CDDSBatchJob::DoWork()
+{
+  CFileItemList items;
+  CUtil::GetRecursiveListing(m_path, items, ".jpg|.png|.tbn");
+
+  unsigned int start = CTimeUtils::GetTimeMS();
+  unsigned int lastLog = start;
+  unsigned int converted = 0, failed = 0, skipped = 0;
+  int64_t bytes = 0;
+
+  CLog::Log(LOGNOTICE, "%s - converting %i images in %s", __FUNCTION__, items.Size(), m_path.c_str());
+  for (int i = 0; i < items.Size(); i++)
+  {
+    if (ShouldCancel(i, items.Size()))
+      break;
+
+    const CStdString &file = items[i]->m_strPath;
+    if (CFile::Exists(URIUtils::ReplaceExtension(file, ".dds")))
+    {
+      skipped++;
+      continue;
+    }
+
+    CDDSJob job(file);
+    if (job.DoWork())
+    {
+      converted++;
+      bytes += items[i]->m_dwSize;
+    }
+    else
+      failed++;
+
+    unsigned int now = CTimeUtils::GetTimeMS();
+    if (now - lastLog > 10000 || i == items.Size() - 1)
+    {
+      float seconds = (now - start) / 1000.0f;
+      CLog::Log(LOGNOTICE, "%s - %i/%i images (%u converted, %u skipped, %u failed) in %.1fs, %.2f images/s, %.1f KB/s",
+                __FUNCTION__, i + 1, items.Size(), converted, skipped, failed, seconds,
+                seconds > 0 ? converted / seconds : 0.0f, seconds > 0 ? bytes / 1024.0f / seconds : 0.0f);
+      lastLog = now;
+    }
+  }
+  return failed == 0;
+}
+
 CTextureCache &CTextureCache::Get()
 {
   static CTextureCache s_cache;
@@ -236,15 +303,37 @@ CStdString CTextureCache::CheckAndCacheImage(const CStdString &url, bool returnD
 
   CStdString originalFile = GetCacheFile(url);
 
+  // several loader threads often want the same image (shared folder thumbs and fanart),
+  // so wait for whoever is already caching it rather than fetching it again
+  boost::shared_ptr<CEvent> caching;
+  {
+    CSingleLock lock(m_cachingSection);
+    std::map<CStdString, boost::shared_ptr<CEvent> >::iterator i = m_caching.find(originalFile);
+    if (i != m_caching.end())
+      caching = i->second;
+    else
+      m_caching[originalFile].reset(new CEvent(true));
+  }
+  if (caching)
+  {
+    caching->Wait();
+    return GetCachedImage(url);
+  }
+
+  CStdString cachedFile;
   CStdString hash = CCacheJob::CacheImage(url, originalFile);
   if (!hash.IsEmpty())
   {
     AddCachedTexture(url, originalFile, hash);
     if (g_advancedSettings.m_useDDSFanart)
       AddJob(new CDDSJob(GetCachedPath(originalFile)));
-    return GetCachedPath(originalFile);
+    cachedFile = GetCachedPath(originalFile);
   }
-  return "";
+
+  CSingleLock lock(m_cachingSection);
+  m_caching[originalFile]->Set();
+  m_caching.erase(originalFile);
+  return cachedFile;
 }
 
 void CTextureCache::ClearCachedImage(const CStdString &url, bool deleteSource /*= false */)
@@ -321,6 +410,12 @@ CStdString CTextureCache::GetCachedPath(const CStdString &file)
   return URIUtils::AddFileToFolder(g_settings.GetThumbnailsFolder(), file);
 }
 
+void CTextureCache::CompressCachedImages(const CStdString &path)
+{
+  // runs outside of our queue so it doesn't hold up caching of other images
+  CJobManager::GetInstance().AddJob(new CDDSBatchJob(path.IsEmpty() ? g_settings.GetThumbnailsFolder() : path), NULL);
+}
+
 void CTextureCache::OnJobComplete(unsigned int jobID, bool success, CJob *job)
 {
   if (strcmp(job->GetType(), "cacheimage") == 0 && success)
@@ -24,6 +24,10 @@
 #include "utils/StdString.h"
 #include "utils/JobManager.h"
 #include "TextureDatabase.h"
+#include "threads/Event.h"
+#include "boost/shared_ptr.hpp"
+
+#include <map>
 
 /*!
  \ingroup textures
@@ -104,6 +108,12 @@ public:
    */
   static CStdString GetUniqueImage(const CStdString &url, const CStdString &extension);
 
+  /*! \brief create .dds versions of all images in a folder that don't have one yet
+   Runs as a background job which logs its progress and throughput.
+   \param path folder to convert (including subfolders), defaults to the thumbnails folder
+   */
+  void CompressCachedImages(const CStdString &path = "");
+
 private:
   /* \brief Job class for creating .dds versions of textures
    */
@@ -119,6 +129,20 @@ private:
     CStdString m_original;
   };
 
+  /* \brief Job class for creating .dds versions of all textures in a folder
+   */
+  class CDDSBatchJob : public CJob
+  {
+  public:
+    CDDSBatchJob(const CStdString &path);
+
+    virtual const char* GetType() const { return "ddsbatch"; };
+    virtual bool operator==(const CJob *job) const;
+    virtual bool DoWork();
+
+    CStdString m_path;
+  };
+
   /*! \brief Job class for caching textures
    */
   class CCacheJob : public CJob
@@ -192,5 +216,8 @@ private:
 
   CCriticalSection m_databaseSection;
   CTextureDatabase m_database;
+
+  CCriticalSection m_cachingSection;
+  std::map<CStdString, boost::shared_ptr<CEvent> > m_caching; ///< images being cached by CheckAndCacheImage, keyed by cache file
 };
 
@@ -32,11 +32,14 @@
 #include "guilib/TextureManager.h"
 #include "TextureCache.h"
 #include "utils/log.h"
+#include "threads/SingleLock.h"
 #include "programs/Shortcut.h"
 #include "video/VideoInfoTag.h"
 
 #include "cores/dvdplayer/DVDFileInfo.h"
 
+#include <algorithm>
+
 using namespace XFILE;
 using namespace std;
 
@@ -163,10 +166,54 @@ CVideoThumbLoader::CVideoThumbLoader() :
 CVideoThumbLoader::~CVideoThumbLoader()
 {
   StopThread();
+  FreeParkedJobs();
 }
 
 void CVideoThumbLoader::OnLoaderStart()
 {
+  // anything parked belongs to the previous listing
+  FreeParkedJobs();
+}
+
+void CVideoThumbLoader::FreeParkedJobs()
+{
+  CSingleLock lock(m_parkedSection);
+  for (vector<CJob *>::iterator it = m_parkedJobs.begin(); it != m_parkedJobs.end(); ++it)
+    delete *it;
+  m_parkedJobs.clear();
+}
+
+void CVideoThumbLoader::FetchItems(const vector<CGUIListItemPtr> &items, unsigned int visible)
+{
+  CThumbLoader::FetchItems(items, visible);
+
+  map<CStdString, unsigned int> rank;
+  for (unsigned int i = 0; i < items.size(); i++)
+  {
+    if (items[i]->IsFileItem())
+      rank.insert(make_pair(static_cast<const CFileItem *>(items[i].get())->m_strPath, i));
+  }
+
+  CSingleLock lock(m_parkedSection);
+  vector<CJob *> jobs;
+  TakeQueuedJobs(jobs);
+  jobs.insert(jobs.end(), m_parkedJobs.begin(), m_parkedJobs.end());
+  m_parkedJobs.clear();
+
+  vector< pair<unsigned int, CJob *> > wanted;
+  for (vector<CJob *>::iterator it = jobs.begin(); it != jobs.end(); ++it)
+  {
+    map<CStdString, unsigned int>::const_iterator i = rank.find(((CThumbExtractor *)*it)->m_listpath);
+    if (i != rank.end())
+      wanted.push_back(make_pair(i->second, *it));
+    else
+      m_parkedJobs.push_back(*it);
+  }
+
+  // the queue starts the newest job first, so add the most urgent last
+  sort(wanted.rbegin(), wanted.rend());
+  for (vector< pair<unsigned int, CJob *> >::iterator it = wanted.begin(); it != wanted.end(); ++it)
+    AddJob(it->second);
 }
 
 void CVideoThumbLoader::OnLoaderFinish()
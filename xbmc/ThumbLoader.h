@@ -101,11 +101,23 @@ public:
    */
   virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
 
+  /*!
+   \brief Load the items near the screen first, and hold back extracting thumbs for those that have scrolled away
+
+   Extractions of items no longer asked for are parked until the items come near the screen again.
+
+   \sa IListItemProvider
+   */
+  virtual void FetchItems(const std::vector<CGUIListItemPtr> &items, unsigned int visible);
+
 protected:
   virtual void OnLoaderStart() ;
   virtual void OnLoaderFinish() ;
+  void FreeParkedJobs();
 
   IStreamDetailsObserver *m_pStreamDetailsObs;
+  std::vector<CJob *> m_parkedJobs;
+  CCriticalSection m_parkedSection;
 };
 
 class CProgramThumbLoader : public CThumbLoader
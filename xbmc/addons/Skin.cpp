@@ -181,9 +181,9 @@ void CSkinInfo::LoadIncludes()
   m_includes.LoadIncludes(includesPath);
 }
 
-void CSkinInfo::ResolveIncludes(TiXmlElement *node)
+void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<CStdString, bool> *conditions)
 {
-  m_includes.ResolveIncludes(node);
+  m_includes.ResolveIncludes(node, conditions);
 }
 
 int CSkinInfo::GetStartWindow() const
@@ -93,7 +93,11 @@ public:
    */
   static bool TranslateResolution(const CStdString &name, RESOLUTION_INFO &res);
 
-  void ResolveIncludes(TiXmlElement *node);
+  void ResolveIncludes(TiXmlElement *node, std::map<CStdString, bool> *conditions = NULL);
+
+  /*! \brief The skin's include files loaded so far
+   */
+  const std::vector<CStdString> &GetIncludeFiles() const { return m_includes.GetFiles(); };
 
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
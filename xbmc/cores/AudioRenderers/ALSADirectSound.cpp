@@ -25,12 +25,18 @@
 #include "settings/GUISettings.h"
 #include "settings/Settings.h"
 #include "utils/log.h"
+#include "utils/MathUtils.h"
+#include "utils/TimeUtils.h"
+#include "threads/SingleLock.h"
 #include "limits.h"
 #include "guilib/LocalizeStrings.h"
 
 #define CHECK_ALSA(l,s,e) if ((e)<0) CLog::Log(l,"%s - %s, alsa error: %d - %s",__FUNCTION__,s,e,snd_strerror(e));
 #define CHECK_ALSA_RETURN(l,s,e) CHECK_ALSA((l),(s),(e)); if ((e)<0) return false;
 
+// periods of audio queued in front of the device
+#define ALSA_RING_PERIODS 4
+
 using namespace std;
 
 static CStdString QuoteDevice(const CStdString& device)
@@ -48,6 +54,12 @@ CALSADirectSound::CALSADirectSound()
 {
   m_pPlayHandle  = NULL;
   m_bIsAllocated = false;
+  m_bFloat = false;
+  m_bConvertFloat = false;
+  m_feeder = NULL;
+  m_bStopFeeder = false;
+  m_feedBuffer = NULL;
+  m_uiFrameBytes = 0;
 }
 
 bool CALSADirectSound::Initialize(IAudioCallback* pCallback, const CStdString& device, int iChannels, enum PCMChannels *channelMap, unsigned int uiSamplesPerSec, unsigned int uiBitsPerSample, bool bResample, bool bIsMusic, bool bPassthrough)
@@ -68,7 +80,8 @@ bool CALSADirectSound::Initialize(IAudioCallback* pCallback, const CStdString& d
   m_uiDataChannels = iChannels;
   m_remap.Reset();
 
-  if (!bPassthrough && channelMap)
+  /* CPCMRemap only handles 16 bit samples */
+  if (!bPassthrough && channelMap && uiBitsPerSample != AUDIO_BITS_FLOAT)
   {
     /* set the input format, and get the channel layout so we know what we need to open */
     outLayout = m_remap.SetInputFormat (iChannels, channelMap, uiBitsPerSample / 8);
@@ -107,6 +120,8 @@ bool CALSADirectSound::Initialize(IAudioCallback* pCallback, const CStdString& d
   m_uiSamplesPerSec = uiSamplesPerSec;
   m_uiBitsPerSample = uiBitsPerSample;
   m_bPassthrough = bPassthrough;
+  m_bFloat = !bPassthrough && uiBitsPerSample == AUDIO_BITS_FLOAT;
+  m_bConvertFloat = false;
 
   m_nCurrentVolume = g_settings.m_nVolumeLevel;
   if (!m_bPassthrough)
@@ -237,8 +252,19 @@ bool CALSADirectSound::Initialize(IAudioCallback* pCallback, const CStdString& d
   nErr = snd_pcm_hw_params_set_access(m_pPlayHandle, hw_params, SND_PCM_ACCESS_RW_INTERLEAVED);
   CHECK_ALSA_RETURN(LOGERROR,"hw_params_set_access",nErr);
 
-  // always use 16 bit samples
-  nErr = snd_pcm_hw_params_set_format(m_pPlayHandle, hw_params, SND_PCM_FORMAT_S16);
+  // use 16 bit samples, unless we're given floats and the device takes them
+  snd_pcm_format_t format = SND_PCM_FORMAT_S16;
+  if (m_bFloat)
+  {
+    if (snd_pcm_hw_params_test_format(m_pPlayHandle, hw_params, SND_PCM_FORMAT_FLOAT) == 0)
+      format = SND_PCM_FORMAT_FLOAT;
+    else
+    {
+      CLog::Log(LOGDEBUG, "CALSADirectSound::Initialize - device does not take float samples, converting to 16 bit");
+      m_bConvertFloat = true;
+    }
+  }
+  nErr = snd_pcm_hw_params_set_format(m_pPlayHandle, hw_params, format);
   CHECK_ALSA_RETURN(LOGERROR,"hw_params_set_format",nErr);
 
   nErr = snd_pcm_hw_params_set_rate_near(m_pPlayHandle, hw_params, &m_uiSamplesPerSec, NULL);
@@ -297,7 +323,19 @@ bool CALSADirectSound::Initialize(IAudioCallback* pCallback, const CStdString& d
   nErr = snd_pcm_prepare (m_pPlayHandle);
   CHECK_ALSA(LOGERROR,"snd_pcm_prepare",nErr);
 
+  /* the ring holds input samples, the device thread de-amps, converts and remaps them */
+  m_uiFrameBytes = m_uiDataChannels * m_uiBitsPerSample / 8;
+  if (!m_ring.Create(m_dwFrameCount * ALSA_RING_PERIODS * m_uiFrameBytes))
+    return false;
+  m_feedBuffer = (unsigned char*)malloc(snd_pcm_frames_to_bytes(m_pPlayHandle, m_dwFrameCount * ALSA_RING_PERIODS));
+  m_stats.Reset((double)m_dwFrameCount / m_uiSamplesPerSec);
+
   m_bIsAllocated = true;
+
+  m_bStopFeeder = false;
+  m_feeder = new CThread(this, "CALSADirectSound");
+  m_feeder->Create();
+  m_feeder->SetPriority(THREAD_PRIORITY_ABOVE_NORMAL);
   return true;
 }
 
@@ -311,6 +349,12 @@ CALSADirectSound::~CALSADirectSound()
 //***********************************************************************************************
 bool CALSADirectSound::Deinitialize()
 {
+  if (m_feeder)
+  {
+    StopFeeder();
+    m_stats.Log("CALSADirectSound::Deinitialize");
+  }
+
   m_bIsAllocated = false;
   if (m_pPlayHandle)
   {
@@ -319,27 +363,48 @@ bool CALSADirectSound::Deinitialize()
   }
 
   m_pPlayHandle=NULL;
+  m_ring.Destroy();
+  free(m_feedBuffer);
+  m_feedBuffer = NULL;
   g_audioContext.SetActiveDevice(CAudioContext::DEFAULT_DEVICE);
   return true;
 }
 
-void CALSADirectSound::Flush()
+void CALSADirectSound::StopFeeder()
 {
-  if (!m_bIsAllocated)
-     return;
+  m_bStopFeeder = true;
+  m_feederWake.Set();
+  m_feeder->StopThread();
+  delete m_feeder;
+  m_feeder = NULL;
+}
 
+void CALSADirectSound::ResetDevice()
+{
   int nErr = snd_pcm_drop(m_pPlayHandle);
   CHECK_ALSA(LOGERROR,"flush-drop",nErr);
   nErr = snd_pcm_prepare(m_pPlayHandle);
   CHECK_ALSA(LOGERROR,"flush-prepare",nErr);
 }
 
+void CALSADirectSound::Flush()
+{
+  if (!m_bIsAllocated)
+     return;
+
+  // we are the producer, and the device thread only reads the ring under the lock
+  CSingleLock lock(m_pcmSection);
+  ResetDevice();
+  m_ring.Reset();
+}
+
 //***********************************************************************************************
 bool CALSADirectSound::Pause()
 {
   if (!m_bIsAllocated)
      return -1;
 
+  CSingleLock lock(m_pcmSection);
   if (m_bPause) return true;
   m_bPause = true;
 
@@ -351,7 +416,7 @@ bool CALSADirectSound::Pause()
     && state != SND_PCM_STATE_PREPARED)
     {
       CLog::Log(LOGWARNING, "CALSADirectSound::Pause - device in weird state %d", (int)state);
-      Flush();
+      ResetDevice();
     }
     return true;
   }
@@ -372,7 +437,7 @@ bool CALSADirectSound::Pause()
       delay = (snd_pcm_sframes_t)m_uiBufferSize - avail;
 
     CLog::Log(LOGWARNING, "CALSADirectSound::CALSADirectSound - device is not able to pause playback, will flush and prefix with %d frames", (int)delay);
-    Flush();
+    ResetDevice();
 
     if(delay > 0)
     {
@@ -392,6 +457,7 @@ bool CALSADirectSound::Resume()
   if (!m_bIsAllocated)
      return -1;
 
+  CSingleLock lock(m_pcmSection);
   snd_pcm_state_t state = snd_pcm_state(m_pPlayHandle);
   if(state == SND_PCM_STATE_PAUSED)
     snd_pcm_pause(m_pPlayHandle,0);
@@ -404,6 +470,7 @@ bool CALSADirectSound::Resume()
   }
 
   m_bPause = false;
+  m_feederWake.Set();
 
   return true;
 }
@@ -462,14 +529,18 @@ unsigned int CALSADirectSound::GetSpaceFrames()
     if(state != SND_PCM_STATE_RUNNING && state != SND_PCM_STATE_PREPARED && !m_bPause)
     {
       CLog::Log(LOGWARNING,"CALSADirectSound::GetSpace - buffer underun (%d)", state);
-      Flush();
+      m_stats.AddUnderrun();
+      ResetDevice();
       return m_uiBufferSize;
     }
   }
   if (nSpace < 0)
   {
-     CLog::Log(LOGWARNING,"CALSADirectSound::GetSpace - get space failed. err: %d (%s)", nSpace, snd_strerror(nSpace));
-     Flush();
+     if (nSpace == -EPIPE)
+       m_stats.AddUnderrun();
+     else
+       CLog::Log(LOGWARNING,"CALSADirectSound::GetSpace - get space failed. err: %d (%s)", nSpace, snd_strerror(nSpace));
+     ResetDevice();
      return m_uiBufferSize;
   }
   return nSpace;
@@ -477,7 +548,10 @@ unsigned int CALSADirectSound::GetSpaceFrames()
 
 unsigned int CALSADirectSound::GetSpace()
 {
-  return GetSpaceFrames() * m_uiDataChannels * m_uiBitsPerSample / 8;
+  if (!m_bIsAllocated) return 0;
+
+  unsigned int space = m_ring.GetWriteSize();
+  return space - space % m_uiFrameBytes;
 }
 
 //***********************************************************************************************
@@ -493,68 +567,115 @@ unsigned int CALSADirectSound::AddPackets(const void* data, unsigned int len)
   if(m_bPause)
     return 0;
 
-  int framesToWrite, bytesToWrite;
+  unsigned int bytes = std::min(len, m_ring.GetWriteSize());
+  bytes -= bytes % m_uiFrameBytes;
+  if (bytes == 0)
+    return 0;
 
-  framesToWrite  = std::min(GetSpaceFrames(), len / ( m_uiDataChannels * m_uiBitsPerSample / 8 ) );
-  framesToWrite /= m_dwFrameCount;
-  framesToWrite *= m_dwFrameCount;
-  bytesToWrite   = snd_pcm_frames_to_bytes(m_pPlayHandle, framesToWrite);
+  // the device thread only sleeps on the event once it has drained the ring
+  bool wake = m_ring.GetReadSize() == 0;
+  m_ring.Write(data, bytes);
+  if (wake)
+    m_feederWake.Set();
 
-  if(framesToWrite == 0)
+  return bytes;
+}
+
+//***********************************************************************************************
+void CALSADirectSound::Run()
+{
+  int64_t freq = CurrentHostFrequency();
+  int64_t last = 0;
+  int timeout = std::max(1, (int)(m_dwFrameCount * 2000 / m_uiSamplesPerSec));
+
+  while (!m_bStopFeeder)
   {
-    // if we haven't started playback, do so now
-    if(snd_pcm_state(m_pPlayHandle) == SND_PCM_STATE_PREPARED && !m_bPause)
-      snd_pcm_start(m_pPlayHandle);
-    return 0;
+    // idle time is not jitter, so start over after waiting for data
+    if (m_bPause || m_ring.GetReadSize() == 0)
+    {
+      last = 0;
+      m_feederWake.WaitMSec(timeout);
+      continue;
+    }
+
+    int nErr = snd_pcm_wait(m_pPlayHandle, timeout);
+    int64_t now = CurrentHostCounter();
+
+    CSingleLock lock(m_pcmSection);
+    bool running = snd_pcm_state(m_pPlayHandle) == SND_PCM_STATE_RUNNING;
+    if (running && last && nErr > 0)
+      m_stats.AddWakeup((double)(now - last) / freq);
+    last = running ? now : 0;
+
+    Feed();
   }
+}
+
+void CALSADirectSound::Feed()
+{
+  if (m_bPause)
+    return;
+
+  snd_pcm_sframes_t avail = GetSpaceFrames();
+
+  void *data;
+  snd_pcm_sframes_t frames = std::min(avail, (snd_pcm_sframes_t)(m_ring.Peek(&data) / m_uiFrameBytes));
+  if (frames <= 0)
+    return;
 
   // handle volume de-amp
-  if (!m_bPassthrough)
-    m_amp.DeAmplify((short *)data, framesToWrite * m_uiDataChannels);
+  if (m_bFloat)
+    m_amp.DeAmplify((float *)data, frames * m_uiDataChannels);
+  else if (!m_bPassthrough)
+    m_amp.DeAmplify((short *)data, frames * m_uiDataChannels);
 
-  int writeResult;
+  const void *outData = data;
   if (m_bPassthrough && m_nCurrentVolume == VOLUME_MINIMUM)
   {
-    char dummy[bytesToWrite];
-    memset(dummy,0,sizeof(dummy));
-    writeResult = snd_pcm_writei(m_pPlayHandle, dummy, framesToWrite);
+    memset(m_feedBuffer, 0, snd_pcm_frames_to_bytes(m_pPlayHandle, frames));
+    outData = m_feedBuffer;
   }
-  else
+  else if (m_remap.CanRemap())
   {
-    if (m_remap.CanRemap())
-    {
-      /* remap the data to the correct channels */
-      uint8_t outData[bytesToWrite];
-      m_remap.Remap((void *)data, outData, framesToWrite);
-      writeResult = snd_pcm_writei(m_pPlayHandle, outData, framesToWrite);
-    }
-    else
-      writeResult = snd_pcm_writei(m_pPlayHandle, data, framesToWrite);
+    /* remap the data to the correct channels */
+    m_remap.Remap(data, m_feedBuffer, frames);
+    outData = m_feedBuffer;
   }
-  if (  writeResult == -EPIPE  )
+  else if (m_bConvertFloat)
   {
-    CLog::Log(LOGDEBUG, "CALSADirectSound::AddPackets - buffer underun (tried to write %d frames)",
-            framesToWrite);
-    Flush();
-    return 0;
+    /* device only does 16 bit, so convert as late as possible */
+    int samples = frames * m_uiDataChannels;
+    int16_t *out = (int16_t *)m_feedBuffer;
+    const float *in = (const float *)data;
+    for (int i = 0; i < samples; i++)
+      out[i] = MathUtils::round_int(std::max(std::min(in[i], 1.0f), -1.0f) * 32767.0f);
+    outData = m_feedBuffer;
   }
-  else if (writeResult != framesToWrite)
+
+  int writeResult = snd_pcm_writei(m_pPlayHandle, outData, frames);
+  if (writeResult == -EPIPE)
   {
-    CLog::Log(LOGERROR, "CALSADirectSound::AddPackets - failed to write %d frames. "
-            "bad write (err: %d) - %s",
-            framesToWrite, writeResult, snd_strerror(writeResult));
-    Flush();
+    CLog::Log(LOGDEBUG, "CALSADirectSound::Feed - buffer underun (tried to write %d frames)", (int)frames);
+    m_stats.AddUnderrun();
+    ResetDevice();
+    avail = m_uiBufferSize;
+    writeResult = snd_pcm_writei(m_pPlayHandle, outData, frames);
   }
 
-  if (writeResult > 0)
+  if (writeResult != frames)
   {
-    if(snd_pcm_state(m_pPlayHandle) == SND_PCM_STATE_PREPARED && !m_bPause && GetSpaceFrames()  <= m_dwFrameCount)
-      snd_pcm_start(m_pPlayHandle);
-    
-    return writeResult * m_uiBitsPerSample * m_uiDataChannels / 8;
+    CLog::Log(LOGERROR, "CALSADirectSound::Feed - failed to write %d frames. "
+            "bad write (err: %d) - %s",
+            (int)frames, writeResult, snd_strerror(writeResult));
+    ResetDevice();
   }
 
-  return 0;
+  // samples are de-amped in place, so never hand them to the device twice
+  m_ring.Skip(frames * m_uiFrameBytes);
+
+  if (writeResult > 0 && avail - writeResult <= (snd_pcm_sframes_t)m_dwFrameCount
+  && snd_pcm_state(m_pPlayHandle) == SND_PCM_STATE_PREPARED)
+    snd_pcm_start(m_pPlayHandle);
 }
 
 //***********************************************************************************************
@@ -565,12 +686,13 @@ float CALSADirectSound::GetDelay()
 
   snd_pcm_sframes_t frames = 0;
 
+  CSingleLock lock(m_pcmSection);
   int nErr = snd_pcm_delay(m_pPlayHandle, &frames);
   CHECK_ALSA(LOGERROR,"snd_pcm_delay",nErr);
   if (nErr < 0)
   {
     frames = 0;
-    Flush();
+    ResetDevice();
   }
 
   if (frames < 0)
@@ -581,17 +703,30 @@ float CALSADirectSound::GetDelay()
     frames = 0;
   }
 
+  // whatever is still queued for the device thread plays after the device delay
+  frames += m_ring.GetReadSize() / m_uiFrameBytes;
+
   return (double)frames / m_uiSamplesPerSec;
 }
 
 float CALSADirectSound::GetCacheTime()
 {
-  return (float)(m_uiBufferSize - GetSpaceFrames()) / m_uiSamplesPerSec;
+  if (!m_bIsAllocated)
+    return 0.0f;
+
+  CSingleLock lock(m_pcmSection);
+  unsigned int frames = m_uiBufferSize - GetSpaceFrames() + m_ring.GetReadSize() / m_uiFrameBytes;
+  return (float)frames / m_uiSamplesPerSec;
 }
 
 float CALSADirectSound::GetCacheTotal()
 {
-  return (float)m_uiBufferSize / m_uiSamplesPerSec;
+  return (float)(m_uiBufferSize + m_ring.GetSize() / std::max(m_uiFrameBytes, 1u)) / m_uiSamplesPerSec;
+}
+
+CStdString CALSADirectSound::GetTimingInfo()
+{
+  return m_stats.GetSummary();
 }
 
 //***********************************************************************************************
@@ -620,6 +755,18 @@ void CALSADirectSound::WaitCompletion()
   if (!m_bIsAllocated || m_bPause)
     return;
 
+  // let the device thread hand over what is left in the ring
+  unsigned int period = std::max(1u, (unsigned int)(m_dwFrameCount * 1000 / m_uiSamplesPerSec));
+  for (int i = 0; i < 2 * ALSA_RING_PERIODS && m_ring.GetReadSize() > 0 && !m_bPause; i++)
+    Sleep(period);
+
+  {
+    // the tail may not fill the device buffer, so it would never start by itself
+    CSingleLock lock(m_pcmSection);
+    if (snd_pcm_state(m_pPlayHandle) == SND_PCM_STATE_PREPARED && !m_bPause)
+      snd_pcm_start(m_pPlayHandle);
+  }
+
   snd_pcm_wait(m_pPlayHandle, -1);
 }
 
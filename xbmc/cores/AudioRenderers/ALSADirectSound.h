@@ -36,11 +36,15 @@
 #include <alsa/asoundlib.h>
 
 #include "../../utils/PCMAmplifier.h"
+#include "AudioRenderRing.h"
+#include "threads/Thread.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
 
 extern void RegisterAudioCallback(IAudioCallback* pCallback);
 extern void UnRegisterAudioCallback();
 
-class CALSADirectSound : public IAudioRenderer
+class CALSADirectSound : public IAudioRenderer, public IRunnable
 {
 public:
   virtual void UnRegisterAudioCallback();
@@ -68,9 +72,16 @@ public:
   virtual void SwitchChannels(int iAudioStream, bool bAudioOnAllSpeakers);
 
   virtual void Flush();
+  virtual CStdString GetTimingInfo();
   static void EnumerateAudioSinks(AudioSinkList& vAudioSinks, bool passthrough);
+protected:
+  virtual void Run();
+
 private:
   unsigned int GetSpaceFrames();
+  void Feed();
+  void ResetDevice();
+  void StopFeeder();
   static bool SoundDeviceExists(const CStdString& device);
   static void GenSoundLabel(AudioSinkList& vAudioSinks, CStdString sink, CStdString card, CStdString readableCard);
   snd_pcm_t 		*m_pPlayHandle;
@@ -91,6 +102,19 @@ private:
   unsigned int m_uiChannels;
 
   bool m_bPassthrough;
+  bool m_bFloat;          // we're given float samples
+  bool m_bConvertFloat;   // ...but the device only takes 16 bit
+
+  // AddPackets only queues into m_ring, m_feeder moves the data on to alsa.
+  // m_pcmSection serializes everything touching m_pPlayHandle after Initialize.
+  CAudioRenderRing  m_ring;
+  CAudioRenderStats m_stats;
+  CThread          *m_feeder;
+  volatile bool     m_bStopFeeder;
+  CEvent            m_feederWake;
+  CCriticalSection  m_pcmSection;
+  unsigned char    *m_feedBuffer;
+  unsigned int      m_uiFrameBytes;
 };
 
 #endif
@@ -0,0 +1,205 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "AudioRenderRing.h"
+#include "threads/Atomics.h"
+#include "utils/log.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+static inline long LoadPosition(volatile long *pos)
+{
+  return cas(pos, 0, 0);
+}
+
+static inline void StorePosition(volatile long *pos, long value)
+{
+  long old = *pos;
+  while (cas(pos, old, value) != old)
+    old = *pos;
+}
+
+CAudioRenderRing::CAudioRenderRing()
+{
+  m_buffer = NULL;
+  m_size   = 0;
+  m_read   = 0;
+  m_write  = 0;
+}
+
+CAudioRenderRing::~CAudioRenderRing()
+{
+  Destroy();
+}
+
+bool CAudioRenderRing::Create(unsigned int size)
+{
+  Destroy();
+  m_buffer = (unsigned char*)malloc(size);
+  if (!m_buffer)
+    return false;
+  m_size = size;
+  return true;
+}
+
+void CAudioRenderRing::Destroy()
+{
+  free(m_buffer);
+  m_buffer = NULL;
+  m_size   = 0;
+  Reset();
+}
+
+void CAudioRenderRing::Reset()
+{
+  StorePosition(&m_read, 0);
+  StorePosition(&m_write, 0);
+}
+
+/* the positions wrap at twice the size, so a full ring (write = read + size) and an
+   empty one (write = read) stay apart without the size having to be a power of two */
+unsigned int CAudioRenderRing::GetUsed(long write, long read) const
+{
+  return write >= read ? (unsigned int)(write - read) : (unsigned int)(write + 2 * (long)m_size - read);
+}
+
+long CAudioRenderRing::Advance(long pos, unsigned int len) const
+{
+  pos += len;
+  if (pos >= 2 * (long)m_size)
+    pos -= 2 * (long)m_size;
+  return pos;
+}
+
+unsigned int CAudioRenderRing::GetWriteSize()
+{
+  return m_size - GetUsed(m_write, LoadPosition(&m_read));
+}
+
+unsigned int CAudioRenderRing::Write(const void *data, unsigned int len)
+{
+  len = std::min(len, GetWriteSize());
+  if (len == 0)
+    return 0;
+
+  unsigned int pos   = m_write >= (long)m_size ? m_write - m_size : m_write;
+  unsigned int first = std::min(len, m_size - pos);
+  memcpy(m_buffer + pos, data, first);
+  if (first < len)
+    memcpy(m_buffer, (const unsigned char*)data + first, len - first);
+
+  StorePosition(&m_write, Advance(m_write, len));
+  return len;
+}
+
+unsigned int CAudioRenderRing::GetReadSize()
+{
+  return GetUsed(LoadPosition(&m_write), m_read);
+}
+
+unsigned int CAudioRenderRing::Peek(void **data)
+{
+  unsigned int len = GetReadSize();
+  if (len == 0)
+    return 0;
+
+  unsigned int pos = m_read >= (long)m_size ? m_read - m_size : m_read;
+  *data = m_buffer + pos;
+  return std::min(len, m_size - pos);
+}
+
+void CAudioRenderRing::Skip(unsigned int len)
+{
+  len = std::min(len, GetReadSize());
+  StorePosition(&m_read, Advance(m_read, len));
+}
+
+// upper bounds of the jitter histogram buckets in ms, the last bucket takes the rest
+const double CAudioRenderStats::m_limits[CAudioRenderStats::BUCKETS - 1] = { 1.0, 2.0, 5.0, 10.0, 20.0, 50.0 };
+
+CAudioRenderStats::CAudioRenderStats()
+{
+  Reset(0.0);
+}
+
+void CAudioRenderStats::Reset(double period)
+{
+  m_period    = period;
+  m_jitterSum = 0.0;
+  m_jitterMax = 0.0;
+  m_wakeups   = 0;
+  m_underruns = 0;
+  memset(m_histogram, 0, sizeof(m_histogram));
+}
+
+void CAudioRenderStats::AddWakeup(double interval)
+{
+  double jitter = fabs(interval - m_period) * 1000.0;
+
+  int bucket = 0;
+  while (bucket < BUCKETS - 1 && jitter >= m_limits[bucket])
+    bucket++;
+
+  m_histogram[bucket]++;
+  m_jitterSum += jitter;
+  m_jitterMax  = std::max(m_jitterMax, jitter);
+  m_wakeups++;
+}
+
+void CAudioRenderStats::AddUnderrun()
+{
+  m_underruns++;
+}
+
+CStdString CAudioRenderStats::GetSummary() const
+{
+  CStdString summary;
+  if (m_wakeups)
+    summary.Format("jit:%.1f/%.1fms, xr:%u", m_jitterSum / m_wakeups, m_jitterMax, m_underruns);
+  else
+    summary.Format("xr:%u", m_underruns);
+  return summary;
+}
+
+void CAudioRenderStats::Log(const char *name) const
+{
+  CStdString histogram, bucket;
+  for (int i = 0; i < BUCKETS; i++)
+  {
+    if (i < BUCKETS - 1)
+      bucket.Format("<%.0fms:%u ", m_limits[i], m_histogram[i]);
+    else
+      bucket.Format(">=%.0fms:%u", m_limits[BUCKETS - 2], m_histogram[i]);
+    histogram += bucket;
+  }
+
+  CLog::Log(LOGDEBUG, "%s - period:%.1fms, wakeups:%u, underruns:%u, jitter avg:%.2fms max:%.2fms, histogram %s"
+                    , name
+                    , m_period * 1000.0
+                    , m_wakeups
+                    , m_underruns
+                    , m_wakeups ? m_jitterSum / m_wakeups : 0.0
+                    , m_jitterMax
+                    , histogram.c_str());
+}
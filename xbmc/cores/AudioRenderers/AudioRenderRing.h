@@ -0,0 +1,117 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#ifndef __AUDIO_RENDER_RING_H__
+#define __AUDIO_RENDER_RING_H__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif // _MSC_VER > 1000
+
+#include "utils/StdString.h"
+
+/*! \brief Single producer, single consumer byte ring.
+
+ The player thread writes, the renderer's device thread reads. Neither side takes a
+ lock - each one only ever moves its own position forward and publishes it with a
+ barrier, so the other side sees the data before it sees the position.
+ */
+class CAudioRenderRing
+{
+public:
+  CAudioRenderRing();
+  ~CAudioRenderRing();
+
+  bool Create(unsigned int size);
+  void Destroy();
+
+  /*! \brief Drop all data. Only safe while neither side is using the ring.
+   */
+  void Reset();
+
+  unsigned int GetSize() const { return m_size; }
+
+  /*! \brief Producer side: free space and append data.
+   \return the number of bytes copied, which may be less than len when the ring is full.
+   */
+  unsigned int GetWriteSize();
+  unsigned int Write(const void *data, unsigned int len);
+
+  /*! \brief Consumer side: the number of bytes queued, and zero copy access to them.
+   Peek returns the contiguous part at the read position, Skip releases it.
+   */
+  unsigned int GetReadSize();
+  unsigned int Peek(void **data);
+  void Skip(unsigned int len);
+
+private:
+  unsigned int GetUsed(long write, long read) const;
+  long Advance(long pos, unsigned int len) const;
+
+  unsigned char *m_buffer;
+  unsigned int   m_size;
+  volatile long  m_read;   ///< bytes read modulo 2 * m_size, only written by the consumer
+  volatile long  m_write;  ///< bytes written modulo 2 * m_size, only written by the producer
+};
+
+/*! \brief Wake-up jitter and underrun statistics of a renderer's device thread.
+
+ Updated from the device thread only, read from anywhere - the counters are plain
+ integers, so a reader may see a slightly stale histogram but never a broken one.
+ */
+class CAudioRenderStats
+{
+public:
+  CAudioRenderStats();
+
+  /*! \brief Start over, expecting a wake-up every period seconds.
+   */
+  void Reset(double period);
+
+  /*! \brief Record the time between two consecutive wake-ups of the device thread.
+   */
+  void AddWakeup(double interval);
+  void AddUnderrun();
+
+  unsigned int GetUnderruns() const { return m_underruns; }
+
+  /*! \brief Short summary for the codec info overlay.
+   */
+  CStdString GetSummary() const;
+
+  /*! \brief Log the full jitter histogram.
+   */
+  void Log(const char *name) const;
+
+  enum { BUCKETS = 7 };
+
+private:
+  static const double m_limits[BUCKETS - 1];
+
+  double       m_period;
+  double       m_jitterSum;
+  double       m_jitterMax;
+  unsigned int m_wakeups;
+  unsigned int m_underruns;
+  unsigned int m_histogram[BUCKETS];
+};
+
+#endif
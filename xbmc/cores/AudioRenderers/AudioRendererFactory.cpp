@@ -181,6 +181,25 @@ void CAudioRendererFactory::EnumerateAudioSinks(AudioSinkList& vAudioSinks, bool
 #endif
 }
 
+bool CAudioRendererFactory::SupportsFloat()
+{
+#if defined(_LINUX) && !defined(__APPLE__)
+  CStdString deviceString = g_guiSettings.GetString("audiooutput.audiodevice");
+  if (deviceString.Equals("custom"))
+    deviceString = g_guiSettings.GetString("audiooutput.customdevice");
+
+  // autodetection only ever picks PulseAudio or ALSA here, both of which do float
+  int iPos = deviceString.Find(":");
+  if (iPos <= 0)
+    return true;
+
+  CStdString soundsystem = deviceString.Left(iPos);
+  return soundsystem.Equals("alsa") || soundsystem.Equals("pulse");
+#else
+  return false;
+#endif
+}
+
 IAudioRenderer *CAudioRendererFactory::CreateFromUri(const CStdString &soundsystem, CStdString &renderer)
 {
 #ifdef HAS_PULSEAUDIO
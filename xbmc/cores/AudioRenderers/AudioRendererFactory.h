@@ -33,6 +33,8 @@ class CAudioRendererFactory
 public:
   static IAudioRenderer *Create(IAudioCallback* pCallback, int iChannels, enum PCMChannels *channelMap, unsigned int uiSamplesPerSec, unsigned int uiBitsPerSample, bool bResample, bool bIsMusic, bool bPassthrough);
   static void EnumerateAudioSinks(AudioSinkList& vAudioSinks, bool passthrough);
+  // true if the configured (non passthrough) renderer takes AUDIO_BITS_FLOAT samples
+  static bool SupportsFloat();
 private:
   static IAudioRenderer *CreateFromUri(const CStdString &soundsystem, CStdString &renderer);
 };
@@ -35,6 +35,10 @@
 extern void RegisterAudioCallback(IAudioCallback* pCallback);
 extern void UnRegisterAudioCallback();
 
+// bits per sample value asking Initialize() for native endian float samples.
+// Only pass it if CAudioRendererFactory::SupportsFloat() says so.
+#define AUDIO_BITS_FLOAT 32
+
 typedef std::pair<CStdString, CStdString> AudioSink;
 typedef std::vector<AudioSink> AudioSinkList;
 
@@ -67,6 +71,9 @@ public:
   virtual void WaitCompletion() = 0;
   virtual void SwitchChannels(int iAudioStream, bool bAudioOnAllSpeakers) = 0;
 
+  // device thread wake-up jitter and underruns, for the codec info overlay
+  virtual CStdString GetTimingInfo() { return ""; }
+
 protected:
   CPCMRemap m_remap;
 
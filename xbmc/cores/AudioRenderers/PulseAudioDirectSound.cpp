@@ -26,6 +26,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 #include "Util.h"
 #include "guilib/LocalizeStrings.h"
 
@@ -105,12 +106,6 @@ static void StreamStateCallback(pa_stream *s, void *userdata)
   }
 }
 
-static void StreamRequestCallback(pa_stream *s, size_t length, void *userdata)
-{
-  pa_threaded_mainloop *m = (pa_threaded_mainloop *)userdata;
-  pa_threaded_mainloop_signal(m, 0);
-}
-
 static void StreamLatencyUpdateCallback(pa_stream *s, void *userdata)
 {
   pa_threaded_mainloop *m = (pa_threaded_mainloop *)userdata;
@@ -140,6 +135,27 @@ static void SinkInfo(pa_context *c, const pa_sink_info *i, int eol, void *userda
 
 /* PulseAudio class memberfunctions*/
 
+void CPulseAudioDirectSound::StreamRequestCallback(pa_stream *s, size_t length, void *userdata)
+{
+  CPulseAudioDirectSound *renderer = (CPulseAudioDirectSound *)userdata;
+
+  // called from the mainloop thread, which holds the mainloop lock
+  int64_t now = CurrentHostCounter();
+  if (renderer->m_lastRequest && !renderer->m_bPause)
+    renderer->m_stats.AddWakeup((double)(now - renderer->m_lastRequest) / CurrentHostFrequency());
+  renderer->m_lastRequest = renderer->m_bPause ? 0 : now;
+
+  pa_threaded_mainloop_signal(renderer->m_MainLoop, 0);
+}
+
+void CPulseAudioDirectSound::StreamUnderflowCallback(pa_stream *s, void *userdata)
+{
+  CPulseAudioDirectSound *renderer = (CPulseAudioDirectSound *)userdata;
+  renderer->m_stats.AddUnderrun();
+  renderer->m_lastRequest = 0;
+  CLog::Log(LOGDEBUG, "PulseAudio: Stream underflow");
+}
+
 CPulseAudioDirectSound::CPulseAudioDirectSound()
 {
 }
@@ -150,7 +166,8 @@ bool CPulseAudioDirectSound::Initialize(IAudioCallback* pCallback, const CStdStr
   m_uiDataChannels = iChannels;
   enum PCMChannels* outLayout = NULL;
 
-  if (!bPassthrough && channelMap)
+  /* CPCMRemap only handles 16 bit samples */
+  if (!bPassthrough && channelMap && uiBitsPerSample != AUDIO_BITS_FLOAT)
   {
     /* set the input format, and get the channel layout so we know what we need to open */
     outLayout = m_remap.SetInputFormat(iChannels, channelMap, uiBitsPerSample / 8);
@@ -175,6 +192,8 @@ bool CPulseAudioDirectSound::Initialize(IAudioCallback* pCallback, const CStdStr
   m_bRecentlyFlushed = true;
   m_bAutoResume = false;
   m_bIsAllocated = false;
+  m_lastRequest = 0;
+  m_lastLatency = 0;
   m_uiChannels = iChannels;
   m_uiSamplesPerSec = uiSamplesPerSec;
   m_uiBufferSize = 0;
@@ -211,7 +230,7 @@ bool CPulseAudioDirectSound::Initialize(IAudioCallback* pCallback, const CStdStr
 
   m_SampleSpec.channels = iChannels;
   m_SampleSpec.rate = uiSamplesPerSec;
-  m_SampleSpec.format = PA_SAMPLE_S16NE;
+  m_SampleSpec.format = uiBitsPerSample == AUDIO_BITS_FLOAT ? PA_SAMPLE_FLOAT32NE : PA_SAMPLE_S16NE;
 
   if (!pa_sample_spec_valid(&m_SampleSpec))
   {
@@ -264,7 +283,8 @@ bool CPulseAudioDirectSound::Initialize(IAudioCallback* pCallback, const CStdStr
   }
 
   pa_stream_set_state_callback(m_Stream, StreamStateCallback, m_MainLoop);
-  pa_stream_set_write_callback(m_Stream, StreamRequestCallback, m_MainLoop);
+  pa_stream_set_write_callback(m_Stream, StreamRequestCallback, this);
+  pa_stream_set_underflow_callback(m_Stream, StreamUnderflowCallback, this);
   pa_stream_set_latency_update_callback(m_Stream, StreamLatencyUpdateCallback, m_MainLoop);
 
   const char *sink = hostdevice.size() < 1 || hostdevice[0].Equals("default") ? NULL : hostdevice[0].c_str();
@@ -315,6 +335,7 @@ bool CPulseAudioDirectSound::Initialize(IAudioCallback* pCallback, const CStdStr
     {
       m_dwPacketSize = a->minreq;
       m_uiBufferSize = a->tlength;
+      m_stats.Reset((double)a->minreq / pa_bytes_per_second(&m_SampleSpec));
       CLog::Log(LOGDEBUG, "PulseAudio: Choosen buffer attributes, maxlength=%u, tlength=%u, prebuf=%u, minreq=%u", a->maxlength, a->tlength, a->prebuf, a->minreq);
     }
   }
@@ -335,6 +356,9 @@ CPulseAudioDirectSound::~CPulseAudioDirectSound()
 
 bool CPulseAudioDirectSound::Deinitialize()
 {
+  if (m_bIsAllocated)
+    m_stats.Log("CPulseAudioDirectSound::Deinitialize");
+
   m_bIsAllocated = false;
 
   if (m_Stream)
@@ -397,6 +421,7 @@ void CPulseAudioDirectSound::Flush()
   pa_threaded_mainloop_lock(m_MainLoop);
   WaitForOperation(pa_stream_flush(m_Stream, NULL, NULL), m_MainLoop, "Flush");
   m_bRecentlyFlushed = true;
+  m_lastRequest = 0;
   pa_threaded_mainloop_unlock(m_MainLoop);
 }
 
@@ -406,6 +431,7 @@ bool CPulseAudioDirectSound::Cork(bool cork)
 
   if (!WaitForOperation(pa_stream_cork(m_Stream, cork ? 1 : 0, NULL, NULL), m_MainLoop, cork ? "Pause" : "Resume"))
     cork = !cork;
+  m_lastRequest = 0;
 
   pa_threaded_mainloop_unlock(m_MainLoop);
 
@@ -559,20 +585,21 @@ float CPulseAudioDirectSound::GetDelay()
   if (!m_bIsAllocated)
     return 0;
 
-  pa_usec_t latency = (pa_usec_t) -1;
+  pa_usec_t latency;
   pa_threaded_mainloop_lock(m_MainLoop);
-  while (pa_stream_get_latency(m_Stream, &latency, NULL) < 0)
-  {
-    if (pa_context_errno(m_Context) != PA_ERR_NODATA)
-    {
-      CLog::Log(LOGERROR, "PulseAudio: pa_stream_get_latency() failed");
-      break;
-    }
-    /* Wait until latency data is available again */
-    pa_threaded_mainloop_wait(m_MainLoop);
-  }
+  if (pa_stream_get_latency(m_Stream, &latency, NULL) == 0)
+    m_lastLatency = latency;
+  else if (pa_context_errno(m_Context) != PA_ERR_NODATA)
+    CLog::Log(LOGERROR, "PulseAudio: pa_stream_get_latency() failed");
+  /* no timing info yet, don't block the player until the next
+     update - the interpolated value from last time is close enough */
   pa_threaded_mainloop_unlock(m_MainLoop);
-  return latency / 1000000.0;
+  return m_lastLatency / 1000000.0;
+}
+
+CStdString CPulseAudioDirectSound::GetTimingInfo()
+{
+  return m_stats.GetSummary();
 }
 
 unsigned int CPulseAudioDirectSound::GetChunkLen()
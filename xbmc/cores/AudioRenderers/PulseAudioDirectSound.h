@@ -32,6 +32,7 @@
 #include <pulse/pulseaudio.h>
 
 #include "../../utils/PCMAmplifier.h"
+#include "AudioRenderRing.h"
 
 extern void RegisterAudioCallback(IAudioCallback* pCallback);
 extern void UnRegisterAudioCallback();
@@ -64,12 +65,15 @@ public:
   virtual void SwitchChannels(int iAudioStream, bool bAudioOnAllSpeakers);
 
   virtual void Flush();
+  virtual CStdString GetTimingInfo();
 
   static void EnumerateAudioSinks(AudioSinkList& vAudioSinks, bool passthrough);
 private:
   static bool SetupContext(const char *host, pa_context **context, pa_threaded_mainloop **mainloop);
   bool Cork(bool cork);
   static inline bool WaitForOperation(pa_operation *op, pa_threaded_mainloop *mainloop, const char *LogEntry);
+  static void StreamRequestCallback(pa_stream *s, size_t length, void *userdata);
+  static void StreamUnderflowCallback(pa_stream *s, void *userdata);
 
   IAudioCallback* m_pCallback;
 
@@ -94,6 +98,11 @@ private:
 
   pa_context *m_Context;
   pa_threaded_mainloop *m_MainLoop;
+
+  // the mainloop thread feeds the server, so it is the one we time
+  CAudioRenderStats m_stats;
+  int64_t m_lastRequest;
+  pa_usec_t m_lastLatency;
 };
 
 #endif
@@ -29,6 +29,7 @@ struct TextCacheStruct_t;
 class TiXmlElement;
 class CStreamDetails;
 class CAction;
+class CVariant;
 
 namespace PVR
 {
@@ -173,6 +174,10 @@ public:
   virtual CStdString GetPlayingTitle() { return ""; };
 
   virtual bool SwitchChannel(const PVR::CPVRChannel &channel) { return false; }
+
+  //per stream timing records of the most recent frames and packets, for diagnosing a/v sync
+  virtual bool GetTelemetry(CVariant &telemetry, unsigned int count = 0) { return false; }
+  virtual bool DumpTelemetry(CStdString &path) { return false; }
 protected:
   IPlayerCallback& m_callback;
 };
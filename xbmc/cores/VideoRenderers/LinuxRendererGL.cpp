@@ -38,6 +38,7 @@
 #include "guilib/Texture.h"
 #include "threads/SingleLock.h"
 #include "DllSwScale.h"
+#include "SliceScaler.h"
 #include "utils/log.h"
 #include "utils/GLUtils.h"
 #include "RenderCapture.h"
@@ -154,10 +155,10 @@ CLinuxRendererGL::CLinuxRendererGL()
 
   m_rgbBuffer = NULL;
   m_rgbBufferSize = 0;
-  m_context = NULL;
   m_rgbPbo = 0;
 
   m_dllSwScale = new DllSwScale;
+  m_sliceScaler = new CSliceScaler(m_dllSwScale);
 }
 
 CLinuxRendererGL::~CLinuxRendererGL()
@@ -178,11 +179,7 @@ CLinuxRendererGL::~CLinuxRendererGL()
     m_rgbBuffer = NULL;
   }
 
-  if (m_context)
-  {
-    m_dllSwScale->sws_freeContext(m_context);
-    m_context = NULL;
-  }
+  delete m_sliceScaler;
 
   if (m_pYUVShader)
   {
@@ -1103,11 +1100,7 @@ void CLinuxRendererGL::UnInit()
   }
   m_rgbBufferSize = 0;
 
-  if (m_context)
-  {
-    m_dllSwScale->sws_freeContext(m_context);
-    m_context = NULL;
-  }
+  m_sliceScaler->Free();
 
   // YV12 textures
   for (int i = 0; i < NUM_BUFFERS; ++i)
@@ -2703,13 +2696,11 @@ void CLinuxRendererGL::ToRGBFrame(YV12Image* im, unsigned flipIndexPlane, unsign
     m_rgbBuffer = (BYTE*)glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB) + PBO_OFFSET;
   }
 
-  m_context = m_dllSwScale->sws_getCachedContext(m_context,
-                                                 im->width, im->height, srcFormat,
-                                                 im->width, im->height, PIX_FMT_BGRA,
-                                                 SWS_FAST_BILINEAR | SwScaleCPUFlags(), NULL, NULL, NULL);
   uint8_t *dst[]       = { m_rgbBuffer, 0, 0, 0 };
   int      dstStride[] = { m_sourceWidth * 4, 0, 0, 0 };
-  m_dllSwScale->sws_scale(m_context, src, srcStride, 0, im->height, dst, dstStride);
+  m_sliceScaler->Scale(srcFormat, im->width, im->height, src, srcStride,
+                       PIX_FMT_BGRA, im->width, im->height, dst, dstStride,
+                       SWS_FAST_BILINEAR | SwScaleCPUFlags());
 
   if (m_rgbPbo)
   {
@@ -2782,18 +2773,18 @@ void CLinuxRendererGL::ToRGBFields(YV12Image* im, unsigned flipIndexPlaneTop, un
     m_rgbBuffer = (BYTE*)glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB) + PBO_OFFSET;
   }
 
-  m_context = m_dllSwScale->sws_getCachedContext(m_context,
-                                                 im->width, im->height >> 1, srcFormat,
-                                                 im->width, im->height >> 1, PIX_FMT_BGRA,
-                                                 SWS_FAST_BILINEAR | SwScaleCPUFlags(), NULL, NULL, NULL);
   uint8_t *dstTop[]    = { m_rgbBuffer, 0, 0, 0 };
   uint8_t *dstBot[]    = { m_rgbBuffer + m_sourceWidth * m_sourceHeight * 2, 0, 0, 0 };
   int      dstStride[] = { m_sourceWidth * 4, 0, 0, 0 };
 
   //convert each YUV field to an RGB field, the top field is placed at the top of the rgb buffer
   //the bottom field is placed at the bottom of the rgb buffer
-  m_dllSwScale->sws_scale(m_context, srcTop, srcStrideTop, 0, im->height >> 1, dstTop, dstStride);
-  m_dllSwScale->sws_scale(m_context, srcBot, srcStrideBot, 0, im->height >> 1, dstBot, dstStride);
+  m_sliceScaler->Scale(srcFormat, im->width, im->height >> 1, srcTop, srcStrideTop,
+                       PIX_FMT_BGRA, im->width, im->height >> 1, dstTop, dstStride,
+                       SWS_FAST_BILINEAR | SwScaleCPUFlags());
+  m_sliceScaler->Scale(srcFormat, im->width, im->height >> 1, srcBot, srcStrideBot,
+                       PIX_FMT_BGRA, im->width, im->height >> 1, dstBot, dstStride,
+                       SWS_FAST_BILINEAR | SwScaleCPUFlags());
 
   if (m_rgbPbo)
   {
@@ -117,6 +117,7 @@ extern YUVCOEF yuv_coef_ebu;
 extern YUVCOEF yuv_coef_smtp240m;
 
 class DllSwScale;
+class CSliceScaler;
 
 class CLinuxRendererGL : public CBaseRenderer
 {
@@ -291,7 +292,7 @@ protected:
   BYTE              *m_rgbBuffer;  // if software scale is used, this will hold the result image
   unsigned int       m_rgbBufferSize;
   GLuint             m_rgbPbo;
-  struct SwsContext *m_context;
+  CSliceScaler      *m_sliceScaler;
 
   HANDLE m_eventTexturesDone[NUM_BUFFERS];
 
@@ -40,6 +40,7 @@
 #include "windowing/WindowingFactory.h"
 #include "guilib/Texture.h"
 #include "lib/DllSwScale.h"
+#include "SliceScaler.h"
 #include "../dvdplayer/DVDCodecs/Video/OpenMaxVideo.h"
 #include "threads/SingleLock.h"
 #include "RenderCapture.h"
@@ -100,7 +101,7 @@ CLinuxRendererGLES::CLinuxRendererGLES()
   m_rgbBufferSize = 0;
 
   m_dllSwScale = new DllSwScale;
-  m_sw_context = NULL;
+  m_sliceScaler = new CSliceScaler(m_dllSwScale);
 }
 
 CLinuxRendererGLES::~CLinuxRendererGLES()
@@ -121,6 +122,7 @@ CLinuxRendererGLES::~CLinuxRendererGLES()
     m_pYUVShader = NULL;
   }
 
+  delete m_sliceScaler;
   delete m_dllSwScale;
 }
 
@@ -719,11 +721,7 @@ void CLinuxRendererGLES::UnInit()
   for (int i = 0; i < NUM_BUFFERS; ++i)
     (this->*m_textureDelete)(i);
 
-  if (m_dllSwScale && m_sw_context)
-  {
-    m_dllSwScale->sws_freeContext(m_sw_context);
-    m_sw_context = NULL;
-  }
+  m_sliceScaler->Free();
   // cleanup framebuffer object if it was in use
   m_fbo.Cleanup();
   m_bValidated = false;
@@ -1355,16 +1353,13 @@ void CLinuxRendererGLES::UploadYV12Texture(int source)
     yuv420_2_rgb8888_neon(m_rgbBuffer, im->plane[0], im->plane[2], im->plane[1],
       m_sourceWidth, m_sourceHeight, im->stride[0], im->stride[1], m_sourceWidth * 4);
 #else
-    m_sw_context = m_dllSwScale->sws_getCachedContext(m_sw_context,
-      im->width, im->height, PIX_FMT_YUV420P,
-      im->width, im->height, PIX_FMT_RGBA,
-      SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
     uint8_t *src[]  = { im->plane[0], im->plane[1], im->plane[2], 0 };
     int srcStride[] = { im->stride[0], im->stride[1], im->stride[2], 0 };
     uint8_t *dst[]  = { m_rgbBuffer, 0, 0, 0 };
     int dstStride[] = { m_sourceWidth*4, 0, 0, 0 };
-    m_dllSwScale->sws_scale(m_sw_context, src, srcStride, 0, im->height, dst, dstStride);
+    m_sliceScaler->Scale(PIX_FMT_YUV420P, im->width, im->height, src, srcStride,
+                         PIX_FMT_RGBA, im->width, im->height, dst, dstStride,
+                         SWS_FAST_BILINEAR);
 #endif
   }
 
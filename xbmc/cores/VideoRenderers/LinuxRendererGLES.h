@@ -117,7 +117,7 @@ extern YUVCOEF yuv_coef_ebu;
 extern YUVCOEF yuv_coef_smtp240m;
 
 class DllSwScale;
-struct SwsContext;
+class CSliceScaler;
 
 
 class CLinuxRendererGLES : public CBaseRenderer
@@ -263,7 +263,7 @@ protected:
 
   // software scale libraries (fallback if required gl version is not available)
   DllSwScale  *m_dllSwScale;
-  struct SwsContext *m_sw_context;
+  CSliceScaler *m_sliceScaler;
   BYTE	      *m_rgbBuffer;  // if software scale is used, this will hold the result image
   unsigned int m_rgbBufferSize;
 
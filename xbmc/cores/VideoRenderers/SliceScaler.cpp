@@ -0,0 +1,237 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "SliceScaler.h"
+#include "DllSwScale.h"
+#include "threads/Atomics.h"
+#include "threads/Event.h"
+#include "utils/CPUInfo.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+
+// fewer rows than this per slice aren't worth handing to another thread
+#define SLICE_MIN_ROWS      64
+#define SLICE_SUMMARY_MS    60000
+
+namespace
+{
+  struct Slice
+  {
+    struct SwsContext *context;
+    uint8_t           *src[4];
+    int                srcStride[4];
+    int                srcHeight;
+    uint8_t           *dst[4];
+    int                dstStride[4];
+  };
+
+  /* the slices of one frame, shared by the calling thread and the jobs. A job
+     the job manager only starts after the frame is done finds nothing left to
+     do, so it never touches the buffers or contexts of the frame. */
+  class CSliceWork
+  {
+  public:
+    CSliceWork(DllSwScale *dll, unsigned int count)
+      : m_dll(dll), m_count(count), m_next(0), m_left(count)
+    {
+    }
+
+    Slice &operator[](unsigned int slice) { return m_slices[slice]; }
+
+    void Run()
+    {
+      while (true)
+      {
+        long slice = m_next;
+        if (slice >= m_count)
+          return;
+        if (cas(&m_next, slice, slice + 1) != slice)
+          continue;
+
+        Slice &s = m_slices[slice];
+        m_dll->sws_scale(s.context, s.src, s.srcStride, 0, s.srcHeight, s.dst, s.dstStride);
+
+        long left = m_left;
+        while (cas(&m_left, left, left - 1) != left)
+          left = m_left;
+        if (left == 1)
+          m_done.Set();
+      }
+    }
+
+    void Wait() { m_done.Wait(); }
+
+  private:
+    DllSwScale   *m_dll;
+    Slice         m_slices[SLICESCALER_MAX_SLICES];
+    long          m_count;
+    volatile long m_next;
+    volatile long m_left;
+    CEvent        m_done;
+  };
+
+  class CSliceJob : public CJob
+  {
+  public:
+    CSliceJob(const boost::shared_ptr<CSliceWork> &work) : m_work(work) {}
+    virtual bool DoWork() { m_work->Run(); return true; }
+    virtual const char *GetType() const { return "slicescale"; }
+
+  private:
+    boost::shared_ptr<CSliceWork> m_work;
+  };
+
+  // rows of the plane are shifted down by this for subsampled chroma
+  int PlaneShift(int format, int plane)
+  {
+    if (plane == 0)
+      return 0;
+    switch (format)
+    {
+      case PIX_FMT_YUV420P:
+      case PIX_FMT_YUVJ420P:
+      case PIX_FMT_NV12:
+      case PIX_FMT_NV21:
+        return 1;
+      case PIX_FMT_YUV410P:
+        return 2;
+      default:
+        return 0;
+    }
+  }
+}
+
+CSliceScaler::CSliceScaler(DllSwScale *dll)
+{
+  m_dll = dll;
+  for (unsigned int i = 0; i < SLICESCALER_MAX_SLICES; i++)
+    m_contexts[i] = NULL;
+  m_slices = 0;
+  m_frames = 0;
+  m_total = 0;
+  m_max = 0;
+  m_lastSummary = CTimeUtils::GetTimeMS();
+}
+
+CSliceScaler::~CSliceScaler()
+{
+  Free();
+}
+
+void CSliceScaler::Free()
+{
+  for (unsigned int i = 0; i < SLICESCALER_MAX_SLICES; i++)
+  {
+    if (m_contexts[i])
+      m_dll->sws_freeContext(m_contexts[i]);
+    m_contexts[i] = NULL;
+  }
+}
+
+unsigned int CSliceScaler::GetSliceCount(int srcHeight) const
+{
+  unsigned int count = std::min(std::max(g_cpuInfo.getCPUCount(), 1), SLICESCALER_MAX_SLICES);
+  while (count > 1 && srcHeight / (int)count < SLICE_MIN_ROWS)
+    count--;
+  return count;
+}
+
+void CSliceScaler::Scale(int srcFormat, int srcWidth, int srcHeight, uint8_t *src[], int srcStride[],
+                         int dstFormat, int dstWidth, int dstHeight, uint8_t *dst[], int dstStride[],
+                         int flags)
+{
+  int64_t start = CurrentHostCounter();
+
+  /* a scaled frame is converted with one context, scaled slices would each be
+     filtered on their own, with seams where the filter clamps at slice edges */
+  unsigned int count = 1;
+  if (srcWidth == dstWidth && srcHeight == dstHeight)
+    count = GetSliceCount(srcHeight);
+  if (count != m_slices)
+  {
+    CLog::Log(LOGDEBUG, "CSliceScaler::Scale - converting %dx%d frames in %u slices", srcWidth, srcHeight, count);
+    m_slices = count;
+  }
+
+  boost::shared_ptr<CSliceWork> work(new CSliceWork(m_dll, count));
+
+  // slices start on whole chroma rows of both formats
+  int align = 1 << std::max(PlaneShift(srcFormat, 1), PlaneShift(dstFormat, 1));
+
+  int srcTop = 0, dstTop = 0;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    int srcBottom = (i + 1 == count) ? srcHeight : (int)(srcHeight * (i + 1) / count) & ~(align - 1);
+    int dstBottom = (i + 1 == count) ? dstHeight : srcBottom;
+
+    m_contexts[i] = m_dll->sws_getCachedContext(m_contexts[i],
+                                                srcWidth, srcBottom - srcTop, srcFormat,
+                                                dstWidth, dstBottom - dstTop, dstFormat,
+                                                flags, NULL, NULL, NULL);
+    Slice &slice = (*work)[i];
+    slice.context   = m_contexts[i];
+    slice.srcHeight = srcBottom - srcTop;
+    for (int plane = 0; plane < 4; plane++)
+    {
+      slice.src[plane]       = src[plane] ? src[plane] + (srcTop >> PlaneShift(srcFormat, plane)) * srcStride[plane] : NULL;
+      slice.srcStride[plane] = srcStride[plane];
+      slice.dst[plane]       = dst[plane] ? dst[plane] + (dstTop >> PlaneShift(dstFormat, plane)) * dstStride[plane] : NULL;
+      slice.dstStride[plane] = dstStride[plane];
+    }
+
+    srcTop = srcBottom;
+    dstTop = dstBottom;
+  }
+
+  for (unsigned int i = 1; i < count; i++)
+    CJobManager::GetInstance().AddJob(new CSliceJob(work), NULL, CJob::PRIORITY_HIGH);
+
+  work->Run();
+  work->Wait();
+
+  UpdateStats(start);
+}
+
+void CSliceScaler::UpdateStats(int64_t start)
+{
+  int64_t elapsed = CurrentHostCounter() - start;
+  m_frames++;
+  m_total += elapsed;
+  if (elapsed > m_max)
+    m_max = elapsed;
+
+  unsigned int now = CTimeUtils::GetTimeMS();
+  if (now - m_lastSummary >= SLICE_SUMMARY_MS)
+  {
+    double average = (double)m_total * 1000.0 / CurrentHostFrequency() / m_frames;
+    CLog::Log(LOGDEBUG, "CSliceScaler::Scale - %u frames in %u slices took %.2f ms on average, %.2f ms at most, enough for %.0f fps",
+              m_frames, m_slices, average, (double)m_max * 1000.0 / CurrentHostFrequency(), average > 0.0 ? 1000.0 / average : 0.0);
+    m_frames = 0;
+    m_total = 0;
+    m_max = 0;
+    m_lastSummary = now;
+  }
+}
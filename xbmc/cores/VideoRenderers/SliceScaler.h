@@ -0,0 +1,70 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include <stdint.h>
+
+class DllSwScale;
+struct SwsContext;
+
+// most slices a frame is cut into, the job manager runs up to 5 high priority jobs
+#define SLICESCALER_MAX_SLICES 4
+
+/*! \brief Software colour conversion of a frame in horizontal slices.
+
+ Each slice has its own swscale context. Frames that are also scaled are converted
+ with a single context in the calling thread. All but one slice are handed to the job
+ manager, the calling thread converts slices too and returns once every slice is
+ done. Slices nobody picked up yet are converted by whichever thread gets there
+ first, so a busy job manager never makes a frame slower than converting it alone.
+ */
+class CSliceScaler
+{
+public:
+  CSliceScaler(DllSwScale *dll);
+  ~CSliceScaler();
+
+  /*! \brief Convert a frame, arguments as for sws_getCachedContext and sws_scale.
+   Only frames keeping their size are cut into slices.
+   \param flags SWS_* scaler and cpu flags.
+   */
+  void Scale(int srcFormat, int srcWidth, int srcHeight, uint8_t *src[], int srcStride[],
+             int dstFormat, int dstWidth, int dstHeight, uint8_t *dst[], int dstStride[],
+             int flags);
+
+  /*! \brief Free the swscale contexts, they are created again by the next Scale.
+   */
+  void Free();
+
+private:
+  unsigned int GetSliceCount(int srcHeight) const;
+  void UpdateStats(int64_t start);
+
+  DllSwScale        *m_dll;
+  struct SwsContext *m_contexts[SLICESCALER_MAX_SLICES];
+  unsigned int       m_slices;
+
+  // time spent per frame, logged once a minute
+  unsigned int       m_frames;
+  int64_t            m_total;
+  int64_t            m_max;
+  unsigned int       m_lastSummary;
+};
@@ -192,10 +192,10 @@ bool ConvolutionFilterShader::OnEnabled()
   glBindTexture(TEXTARGET, m_kernelTex1);
 
   glActiveTexture(GL_TEXTURE0);
-  glUniform1i(m_hSourceTex, m_sourceTexUnit);
-  glUniform1i(m_hKernTex, 2);
-  glUniform2f(m_hStepXY, m_stepX, m_stepY);
-  glUniform1f(m_hStretch, m_stretch);
+  SetUniform1i(m_hSourceTex, m_sourceTexUnit);
+  SetUniform1i(m_hKernTex, 2);
+  SetUniform2f(m_hStepXY, m_stepX, m_stepY);
+  SetUniform1f(m_hStretch, m_stretch);
   VerifyGLState();
   return true;
 }
@@ -221,8 +221,8 @@ void StretchFilterShader::OnCompiledAndLinked()
 
 bool StretchFilterShader::OnEnabled()
 {
-  glUniform1i(m_hSourceTex, m_sourceTexUnit);
-  glUniform1f(m_hStretch, m_stretch);
+  SetUniform1i(m_hSourceTex, m_sourceTexUnit);
+  SetUniform1f(m_hStretch, m_stretch);
   VerifyGLState();
   return true;
 }
@@ -225,20 +225,20 @@ void BaseYUV2RGBGLSLShader::OnCompiledAndLinked()
 bool BaseYUV2RGBGLSLShader::OnEnabled()
 {
   // set shader attributes once enabled
-  glUniform1i(m_hYTex, 0);
-  glUniform1i(m_hUTex, 1);
-  glUniform1i(m_hVTex, 2);
-  glUniform1f(m_hStretch, m_stretch);
-  glUniform2f(m_hStep, 1.0 / m_width, 1.0 / m_height);
+  SetUniform1i(m_hYTex, 0);
+  SetUniform1i(m_hUTex, 1);
+  SetUniform1i(m_hVTex, 2);
+  SetUniform1f(m_hStretch, m_stretch);
+  SetUniform2f(m_hStep, 1.0 / m_width, 1.0 / m_height);
 
   GLfloat matrix[4][4];
   CalculateYUVMatrixGL(matrix, m_flags, m_black, m_contrast);
 
-  glUniformMatrix4fv(m_hMatrix, 1, GL_FALSE, (GLfloat*)matrix);
+  SetUniformMatrix4fv(m_hMatrix, (GLfloat*)matrix);
 #if HAS_GLES == 2
-  glUniformMatrix4fv(m_hProj,  1, GL_FALSE, m_proj);
-  glUniformMatrix4fv(m_hModel, 1, GL_FALSE, m_model);
-  glUniform1i(m_hAlpha, m_alpha);
+  SetUniformMatrix4fv(m_hProj, m_proj);
+  SetUniformMatrix4fv(m_hModel, m_model);
+  SetUniform1i(m_hAlpha, m_alpha);
 #endif
   VerifyGLState();
   return true;
@@ -309,9 +309,9 @@ bool YUV2RGBBobShader::OnEnabled()
   if(!BaseYUV2RGBGLSLShader::OnEnabled())
     return false;
 
-  glUniform1i(m_hField, m_field);
-  glUniform1f(m_hStepX, 1.0f / (float)m_width);
-  glUniform1f(m_hStepY, 1.0f / (float)m_height);
+  SetUniform1i(m_hField, m_field);
+  SetUniform1f(m_hStepX, 1.0f / (float)m_width);
+  SetUniform1f(m_hStepY, 1.0f / (float)m_height);
   VerifyGLState();
   return true;
 }
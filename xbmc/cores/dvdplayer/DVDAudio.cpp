@@ -346,3 +346,11 @@ double CDVDAudio::GetCacheTotal()
     return 0.0;
   return m_pAudioDecoder->GetCacheTotal();
 }
+
+CStdString CDVDAudio::GetTimingInfo()
+{
+  CSingleLock lock (m_critSection);
+  if(!m_pAudioDecoder)
+    return "";
+  return m_pAudioDecoder->GetTimingInfo();
+}
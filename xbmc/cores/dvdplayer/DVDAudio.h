@@ -67,6 +67,7 @@ public:
   double GetDelay(); // returns the time it takes to play a packet if we add one at this time
   double GetCacheTime();  // returns total amount of data cached in audio output at this time
   double GetCacheTotal(); // returns total amount the audio device can buffer
+  CStdString GetTimingInfo(); // returns the renderer's jitter and underrun summary
   void Flush();
   void Finish();
   void Drain();
@@ -32,6 +32,13 @@
 #define FRAME_TYPE_B 3
 #define FRAME_TYPE_D 4
 
+// decoder skip levels, from full quality to fastest, see SetSkipLevel
+#define VC_SKIP_NONE           0  // decode everything
+#define VC_SKIP_LOOPFILTER     1  // no loop filter on non reference frames
+#define VC_SKIP_LOOPFILTER_ALL 2  // no loop filter at all
+#define VC_SKIP_NONREF         3  // don't decode non reference frames either
+#define VC_SKIP_LEVELS         4
+
 namespace DXVA { class CProcessor; }
 namespace VAAPI { struct CHolder; }
 class CVDPAU;
@@ -204,6 +211,16 @@ public:
    */
   virtual void SetDropState(bool bDrop) = 0;
 
+  /*
+   * will be called by video player when decoding falls behind or catches up again,
+   * one of the VC_SKIP_ levels. Unlike SetDropState this stays in effect until changed.
+   * returns false if the codec can't trade quality for speed
+   */
+  virtual bool SetSkipLevel(int level)
+  {
+    return false;
+  }
+
   /*
    *
    * should return codecs name
@@ -148,6 +148,8 @@ CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg() : CDVDVideoCodec()
   m_iLastKeyframe = 0;
   m_dts = DVD_NOPTS_VALUE;
   m_started = false;
+  m_bDropState = false;
+  m_iSkipLevel = VC_SKIP_NONE;
 }
 
 CDVDVideoCodecFFmpeg::~CDVDVideoCodecFFmpeg()
@@ -258,10 +260,8 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
 #if defined(__APPLE__) && defined(__arm__)
   m_dllAvCodec.avcodec_thread_init(m_pCodecContext, 1);
 #elif defined(_LINUX) || defined(_WIN32)
-  int num_threads = std::min(8 /*MAX_THREADS*/, g_cpuInfo.getCPUCount());
-  if( num_threads > 1 && !hints.software && m_pHardware == NULL // thumbnail extraction fails when run threaded
-  && ( pCodec->id == CODEC_ID_H264
-    || pCodec->id == CODEC_ID_MPEG4 ))
+  int num_threads = GetThreadCount(pCodec, hints);
+  if( num_threads > 1 )
     m_dllAvCodec.avcodec_thread_init(m_pCodecContext, num_threads);
 #endif
 
@@ -282,9 +282,55 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   if(m_pHardware)
     m_name += "-" + m_pHardware->Name();
 
+  if(m_pCodecContext->thread_count > 1)
+  {
+    CStdString threads;
+    threads.Format("-st%d", m_pCodecContext->thread_count);
+    m_name += threads;
+  }
+
   return true;
 }
 
+int CDVDVideoCodecFFmpeg::GetThreadCount(AVCodec* pCodec, CDVDStreamInfo &hints)
+{
+  // thumbnail extraction fails when run threaded
+  if (hints.software || m_pHardware)
+    return 1;
+
+  // the ffmpeg in use only knows slice threading, each thread decodes a band of
+  // macroblock rows of the same picture. codecs that don't split their pictures
+  // would just waste the extra contexts
+  if (pCodec->id == CODEC_ID_MPEG1VIDEO
+  ||  pCodec->id == CODEC_ID_MPEG2VIDEO)
+  {
+#ifdef HAS_DX
+    // dxva may still take over mpeg2 once the format is known
+    if (g_guiSettings.GetBool("videoplayer.usedxva2"))
+      return 1;
+#endif
+  }
+  else if (pCodec->id != CODEC_ID_H264
+       &&  pCodec->id != CODEC_ID_MPEG4)
+    return 1;
+
+  int threads = g_cpuInfo.getCPUCount();
+  if (g_advancedSettings.m_videoDecodeThreads > 0)
+    threads = std::min(threads, g_advancedSettings.m_videoDecodeThreads);
+
+  // ffmpeg refuses more threads than macroblock rows, and bands of only a few
+  // rows spend more time syncing than decoding. small videos get fewer threads
+  int rows = (hints.height + 15) / 16;
+  if (rows > 0)
+    threads = std::min(threads, std::max(1, rows / 4));
+
+  threads = std::max(1, std::min(threads, 16 /*MAX_THREADS*/));
+
+  CLog::Log(LOGNOTICE, "CDVDVideoCodecFFmpeg::GetThreadCount() %d cpus, %dx%d, using %d slice threads"
+                     , g_cpuInfo.getCPUCount(), hints.width, hints.height, threads);
+  return threads;
+}
+
 void CDVDVideoCodecFFmpeg::Dispose()
 {
   if (m_pFrame) m_dllAvUtil.av_free(m_pFrame);
@@ -317,26 +363,53 @@ void CDVDVideoCodecFFmpeg::Dispose()
 
 void CDVDVideoCodecFFmpeg::SetDropState(bool bDrop)
 {
-  if( m_pCodecContext )
-  {
-    // i don't know exactly how high this should be set
-    // couldn't find any good docs on it. think it varies
-    // from codec to codec on what it does
+  m_bDropState = bDrop;
+  UpdateSkipState();
+}
 
-    //  2 seem to be to high.. it causes video to be ruined on following images
-    if( bDrop )
-    {
-      m_pCodecContext->skip_frame = AVDISCARD_NONREF;
-      m_pCodecContext->skip_idct = AVDISCARD_NONREF;
-      m_pCodecContext->skip_loop_filter = AVDISCARD_NONREF;
-    }
-    else
-    {
-      m_pCodecContext->skip_frame = AVDISCARD_DEFAULT;
-      m_pCodecContext->skip_idct = AVDISCARD_DEFAULT;
-      m_pCodecContext->skip_loop_filter = AVDISCARD_DEFAULT;
-    }
+bool CDVDVideoCodecFFmpeg::SetSkipLevel(int level)
+{
+  // hardware decoders don't get any faster from skipping
+  if (!m_pCodecContext || m_pHardware)
+    return false;
+
+  m_iSkipLevel = std::max((int)VC_SKIP_NONE, std::min(level, VC_SKIP_LEVELS - 1));
+  UpdateSkipState();
+  return true;
+}
+
+void CDVDVideoCodecFFmpeg::UpdateSkipState()
+{
+  if( !m_pCodecContext )
+    return;
+
+  AVDiscard skip_frame       = AVDISCARD_DEFAULT;
+  AVDiscard skip_idct        = AVDISCARD_DEFAULT;
+  AVDiscard skip_loop_filter = AVDISCARD_DEFAULT;
+
+  // keep the advanced setting override as the baseline
+  if (g_advancedSettings.m_iSkipLoopFilter != 0)
+    skip_loop_filter = (AVDiscard)g_advancedSettings.m_iSkipLoopFilter;
+
+  // i don't know exactly how high this should be set
+  // couldn't find any good docs on it. think it varies
+  // from codec to codec on what it does
+
+  //  2 seem to be to high.. it causes video to be ruined on following images
+  if( m_bDropState || m_iSkipLevel >= VC_SKIP_NONREF )
+  {
+    skip_frame = AVDISCARD_NONREF;
+    skip_idct  = AVDISCARD_NONREF;
   }
+
+  if( m_iSkipLevel >= VC_SKIP_LOOPFILTER_ALL )
+    skip_loop_filter = AVDISCARD_ALL;
+  else if( (m_bDropState || m_iSkipLevel >= VC_SKIP_LOOPFILTER) && skip_loop_filter < AVDISCARD_NONREF )
+    skip_loop_filter = AVDISCARD_NONREF;
+
+  m_pCodecContext->skip_frame       = skip_frame;
+  m_pCodecContext->skip_idct        = skip_idct;
+  m_pCodecContext->skip_loop_filter = skip_loop_filter;
 }
 
 union pts_union
@@ -60,6 +60,7 @@ public:
   bool GetPictureCommon(DVDVideoPicture* pDvdVideoPicture);
   virtual bool GetPicture(DVDVideoPicture* pDvdVideoPicture);
   virtual void SetDropState(bool bDrop);
+  virtual bool SetSkipLevel(int level);
   virtual const char* GetName() { return m_name.c_str(); }; // m_name is never changed after open
   virtual unsigned GetConvergeCount();
 
@@ -76,6 +77,8 @@ protected:
   static enum PixelFormat GetFormat(struct AVCodecContext * avctx, const PixelFormat * fmt);
 
   void GetVideoAspect(AVCodecContext* CodecContext, unsigned int& iWidth, unsigned int& iHeight);
+  void UpdateSkipState();
+  int  GetThreadCount(AVCodec* pCodec, CDVDStreamInfo &hints);
   AVFrame* m_pFrame;
   AVCodecContext* m_pCodecContext;
 
@@ -96,5 +99,7 @@ protected:
   int m_iLastKeyframe;
   double m_dts;
   bool   m_started;
+  bool   m_bDropState;
+  int    m_iSkipLevel;
 };
 
@@ -73,6 +73,8 @@
 #include "video/dialogs/GUIDialogFullScreenInfo.h"
 #include "utils/StringUtils.h"
 #include "Util.h"
+#include "XBDateTime.h"
+#include "utils/Variant.h"
 
 using namespace std;
 using namespace PVR;
@@ -3956,3 +3958,34 @@ bool CDVDPlayer::SwitchChannel(const CPVRChannel &channel)
   m_messenger.Put(new CDVDMsgType<CPVRChannel>(CDVDMsg::PLAYER_CHANNEL_SELECT, channel));
   return true;
 }
+
+bool CDVDPlayer::GetTelemetry(CVariant &telemetry, unsigned int count)
+{
+  m_dvdPlayerVideo.GetTelemetry().Serialize(telemetry["video"], count);
+  m_dvdPlayerAudio.GetTelemetry().Serialize(telemetry["audio"], count);
+  return true;
+}
+
+bool CDVDPlayer::DumpTelemetry(CStdString &path)
+{
+  CStdString data = CDVDPlayerTelemetry::GetHeader();
+  m_dvdPlayerVideo.GetTelemetry().Format(data, "video");
+  m_dvdPlayerAudio.GetTelemetry().Format(data, "audio");
+
+  CDateTime now = CDateTime::GetCurrentDateTime();
+  path.Format("special://temp/dvdplayer-telemetry-%04i%02i%02i-%02i%02i%02i.csv"
+            , now.GetYear(), now.GetMonth(), now.GetDay()
+            , now.GetHour(), now.GetMinute(), now.GetSecond());
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true))
+  {
+    CLog::Log(LOGERROR, "%s - unable to open %s", __FUNCTION__, path.c_str());
+    return false;
+  }
+  file.Write(data.c_str(), data.size());
+  file.Close();
+
+  CLog::Log(LOGNOTICE, "%s - wrote timing records to %s", __FUNCTION__, path.c_str());
+  return true;
+}
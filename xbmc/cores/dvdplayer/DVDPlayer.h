@@ -226,6 +226,9 @@ public:
 
   virtual bool SwitchChannel(const PVR::CPVRChannel &channel);
 
+  virtual bool GetTelemetry(CVariant &telemetry, unsigned int count = 0);
+  virtual bool DumpTelemetry(CStdString &path);
+
   enum ECacheState
   { CACHESTATE_DONE = 0
   , CACHESTATE_FULL     // player is filling up the demux queue
@@ -234,9 +234,12 @@ void CDVDPlayerAudio::OpenStream( CDVDStreamInfo &hints, CDVDAudioCodec* codec )
   m_integral = 0;
   m_skipdupcount = 0;
   m_prevskipped = false;
+  m_skippedcount = 0;
+  m_duplicatedcount = 0;
   m_syncclock = true;
   m_errortime = CurrentHostCounter();
   m_silence = false;
+  m_telemetry.Reset();
 
   m_maxspeedadjust = g_guiSettings.GetFloat("videoplayer.maxspeedadjust");
 }
@@ -647,7 +650,20 @@ void CDVDPlayerAudio::Process()
       continue;
 
     if (packetadded)
+    {
       HandleSyncError(audioframe.duration);
+
+      DVDTelemetryRecord record;
+      record.time       = m_pClock->GetAbsoluteClock();
+      record.clock      = m_pClock->GetClock();
+      record.pts        = audioframe.pts;
+      record.render     = m_dvdAudio.GetDelay();
+      record.error      = m_ptsOutput.Current() - record.clock;
+      record.dropped    = m_skippedcount;
+      record.duplicated = m_duplicatedcount;
+      record.level      = m_messageQueue.GetLevel();
+      m_telemetry.Add(record);
+    }
   }
 }
 
@@ -796,12 +812,15 @@ bool CDVDPlayerAudio::OutputPacket(DVDAudioFrame &audioframe)
         m_dvdAudio.AddPackets(audioframe);
         m_skipdupcount++;
       }
+      else
+        m_skippedcount++;
     }
     else if (m_skipdupcount > 0)
     {
       m_dvdAudio.AddPackets(audioframe);
       m_dvdAudio.AddPackets(audioframe);
       m_skipdupcount--;
+      m_duplicatedcount++;
     }
     else if (m_skipdupcount == 0)
     {
@@ -906,6 +925,10 @@ string CDVDPlayerAudio::GetPlayerInfo()
   if (m_synctype == SYNC_RESAMPLE)
     s << ", rr:" << fixed << setprecision(5) << 1.0 / m_resampleratio;
 
+  CStdString timing = m_dvdAudio.GetTimingInfo();
+  if (!timing.IsEmpty())
+    s << ", " << timing;
+
   return s.str();
 }
 
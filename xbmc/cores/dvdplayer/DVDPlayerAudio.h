@@ -29,6 +29,7 @@
 #include "DVDStreamInfo.h"
 #include "utils/BitstreamStats.h"
 #include "DVDPlayerAudioResampler.h"
+#include "DVDPlayerTelemetry.h"
 
 #include <list>
 #include <queue>
@@ -117,6 +118,7 @@ public:
 
   std::string GetPlayerInfo();
   int GetAudioBitrate();
+  const CDVDPlayerTelemetry& GetTelemetry() const { return m_telemetry; }
 
   // holds stream information for current playing stream
   CDVDStreamInfo m_streaminfo;
@@ -172,6 +174,7 @@ protected:
   CDVDClock* m_pClock; // dvd master clock
   CDVDAudioCodec* m_pAudioCodec; // audio codec
   BitstreamStats m_audioStats;
+  CDVDPlayerTelemetry m_telemetry;
 
   int     m_speed;
   double  m_droptime;
@@ -203,6 +206,8 @@ protected:
   double m_integral; //integral correction for resampler
   int    m_skipdupcount; //counter for skip/duplicate synctype
   bool   m_prevskipped;
+  int    m_skippedcount; //packets skipped and duplicated so far, for the telemetry
+  int    m_duplicatedcount;
   double m_maxspeedadjust;
   double m_resampleratio; //resample ratio when using SYNC_RESAMPLE, used for the codec info
 };
@@ -0,0 +1,114 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "DVDPlayerTelemetry.h"
+#include "DVDClock.h"
+#include "threads/SingleLock.h"
+#include "utils/Variant.h"
+
+#define TIME_TO_MS(x)  ((x) * 1000.0 / DVD_TIME_BASE)
+#define TIME_TO_SEC(x) ((x) / DVD_TIME_BASE)
+
+CDVDPlayerTelemetry::CDVDPlayerTelemetry()
+{
+  m_records.resize(DVDTELEMETRY_RECORDS);
+  m_next  = 0;
+  m_count = 0;
+}
+
+void CDVDPlayerTelemetry::Reset()
+{
+  CSingleLock lock(m_section);
+  m_next  = 0;
+  m_count = 0;
+}
+
+void CDVDPlayerTelemetry::Add(const DVDTelemetryRecord &record)
+{
+  CSingleLock lock(m_section);
+  m_records[m_next] = record;
+  m_next = (m_next + 1) % m_records.size();
+  if (m_count < m_records.size())
+    m_count++;
+}
+
+void CDVDPlayerTelemetry::GetRecords(std::vector<DVDTelemetryRecord> &records, unsigned int count) const
+{
+  CSingleLock lock(m_section);
+  if (count == 0 || count > m_count)
+    count = m_count;
+
+  records.reserve(records.size() + count);
+  unsigned int first = (m_next + m_records.size() - count) % m_records.size();
+  for (unsigned int i = 0; i < count; i++)
+    records.push_back(m_records[(first + i) % m_records.size()]);
+}
+
+void CDVDPlayerTelemetry::Serialize(CVariant &value, unsigned int count) const
+{
+  std::vector<DVDTelemetryRecord> records;
+  GetRecords(records, count);
+
+  value = CVariant(CVariant::VariantTypeArray);
+  for (unsigned int i = 0; i < records.size(); i++)
+  {
+    const DVDTelemetryRecord &record = records[i];
+    CVariant item(CVariant::VariantTypeObject);
+    item["time"]       = TIME_TO_SEC(record.time);
+    item["clock"]      = TIME_TO_SEC(record.clock);
+    if (record.pts != DVD_NOPTS_VALUE)
+      item["pts"]      = TIME_TO_SEC(record.pts);
+    item["render"]     = TIME_TO_MS(record.render);
+    item["error"]      = TIME_TO_MS(record.error);
+    item["dropped"]    = record.dropped;
+    item["duplicated"] = record.duplicated;
+    item["level"]      = record.level;
+    value.swap_back(item);
+  }
+}
+
+const char *CDVDPlayerTelemetry::GetHeader()
+{
+  return "stream,time,clock,pts,render_ms,error_ms,dropped,duplicated,level\n";
+}
+
+void CDVDPlayerTelemetry::Format(CStdString &out, const char *stream) const
+{
+  std::vector<DVDTelemetryRecord> records;
+  GetRecords(records);
+
+  CStdString line;
+  for (unsigned int i = 0; i < records.size(); i++)
+  {
+    const DVDTelemetryRecord &record = records[i];
+    line.Format("%s,%.6f,%.6f,%.6f,%.3f,%.3f,%d,%d,%d\n"
+              , stream
+              , TIME_TO_SEC(record.time)
+              , TIME_TO_SEC(record.clock)
+              , record.pts == DVD_NOPTS_VALUE ? -1.0 : TIME_TO_SEC(record.pts)
+              , TIME_TO_MS(record.render)
+              , TIME_TO_MS(record.error)
+              , record.dropped
+              , record.duplicated
+              , record.level);
+    out += line;
+  }
+}
@@ -0,0 +1,79 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "threads/CriticalSection.h"
+#include "utils/StdString.h"
+#include <vector>
+
+class CVariant;
+
+// number of records kept per stream, enough for about 40 seconds of 25fps video
+#define DVDTELEMETRY_RECORDS 1024
+
+// all times in DVD_TIME_BASE units
+typedef struct stDVDTelemetryRecord
+{
+  double time;        // absolute clock when the record was taken
+  double clock;       // player clock at that time
+  double pts;         // pts of the frame or packet being output
+  double render;      // time until the frame is shown or the packet is heard
+  double error;       // pts minus clock
+  int    dropped;     // frames or packets dropped so far
+  int    duplicated;  // packets output twice, or pictures repeated by the codec, so far
+  int    level;       // fill level of the stream's message queue in percent
+} DVDTelemetryRecord;
+
+/*! \brief Ring of timing records for one stream of the player.
+
+ The stream's thread adds a record for every frame or packet it outputs, while
+ JSON-RPC or a file dump may read them from any other thread.
+ */
+class CDVDPlayerTelemetry
+{
+public:
+  CDVDPlayerTelemetry();
+
+  void Reset();
+  void Add(const DVDTelemetryRecord &record);
+
+  /*! \brief Copy the most recent records, oldest first.
+   \param records receives the records.
+   \param count maximum number of records, 0 for all.
+   */
+  void GetRecords(std::vector<DVDTelemetryRecord> &records, unsigned int count = 0) const;
+
+  /*! \brief Set a JSON-RPC result to an array of the records as objects, in ms and seconds.
+   */
+  void Serialize(CVariant &value, unsigned int count = 0) const;
+
+  /*! \brief Format the records as CSV lines prefixed with the stream name.
+   */
+  void Format(CStdString &out, const char *stream) const;
+
+  static const char *GetHeader();
+
+private:
+  mutable CCriticalSection        m_section;
+  std::vector<DVDTelemetryRecord> m_records;
+  unsigned int                    m_next;
+  unsigned int                    m_count;
+};
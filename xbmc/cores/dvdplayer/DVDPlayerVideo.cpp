@@ -43,7 +43,9 @@
 #include <iomanip>
 #include <numeric>
 #include <iterator>
+#include <limits.h>
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 using namespace std;
 
@@ -146,8 +148,11 @@ CDVDPlayerVideo::CDVDPlayerVideo( CDVDClock* pClock
 
   m_iCurrentPts = DVD_NOPTS_VALUE;
   m_iDroppedFrames = 0;
+  m_iRepeatedFrames = 0;
   m_fFrameRate = 25;
   m_bAllowFullscreen = false;
+  ResetSkipLevel();
+  memset(m_iSkipFrames, 0, sizeof(m_iSkipFrames));
   memset(&m_output, 0, sizeof(m_output));
 }
 
@@ -217,6 +222,8 @@ void CDVDPlayerVideo::OpenStream(CDVDStreamInfo &hint, CDVDVideoCodec* codec)
   m_iDroppedRequest = 0;
   m_iLateFrames = 0;
   m_autosync = 1;
+  ResetSkipLevel();
+  ResetDecodeTime();
 
   if( m_fFrameRate > 100 || m_fFrameRate < 5 )
   {
@@ -273,6 +280,9 @@ void CDVDPlayerVideo::OnStartup()
 {
   CThread::SetName("CDVDPlayerVideo");
   m_iDroppedFrames = 0;
+  m_iRepeatedFrames = 0;
+  m_telemetry.Reset();
+  memset(m_iSkipFrames, 0, sizeof(m_iSkipFrames));
 
   m_crop.x1 = m_crop.x2 = 0.0f;
   m_crop.y1 = m_crop.y2 = 0.0f;
@@ -494,7 +504,9 @@ void CDVDPlayerVideo::Process()
       // decoder still needs to provide an empty image structure, with correct flags
       m_pVideoCodec->SetDropState(bRequestDrop);
 
+      int64_t decodeStart = CurrentHostCounter();
       int iDecoderState = m_pVideoCodec->Decode(pPacket->pData, pPacket->iSize, pPacket->dts, pPacket->pts);
+      AddDecodeTime((double)(CurrentHostCounter() - decodeStart) * 1000.0 / CurrentHostFrequency());
 
       // buffer packets so we can recover should decoder flush for some reason
       if(m_pVideoCodec->GetConvergeCount() > 0)
@@ -626,7 +638,10 @@ void CDVDPlayerVideo::Process()
             }
 
             if (picture.iRepeatPicture)
+            {
               picture.iDuration *= picture.iRepeatPicture + 1;
+              m_iRepeatedFrames++;
+            }
 
 #if 1
             int iResult = OutputPicture(&picture, pts);
@@ -1083,10 +1098,11 @@ int CDVDPlayerVideo::OutputPicture(DVDVideoPicture* pPicture, double pts)
   pts += m_iVideoDelay;
 
   // calculate the time we need to delay this picture before displaying
-  double iSleepTime, iClockSleep, iFrameSleep, iCurrentClock, iFrameDuration;
+  double iSleepTime, iClockSleep, iFrameSleep, iCurrentClock, iPlayerClock, iFrameDuration;
 
   iCurrentClock = m_pClock->GetAbsoluteClock(); // snapshot current clock
-  iClockSleep = pts - m_pClock->GetClock();  //sleep calculated by pts to clock comparison
+  iPlayerClock = m_pClock->GetClock();
+  iClockSleep = pts - iPlayerClock;  //sleep calculated by pts to clock comparison
   iFrameSleep = m_FlipTimeStamp - iCurrentClock; // sleep calculated by duration of frame
   iFrameDuration = pPicture->iDuration;
 
@@ -1133,6 +1149,20 @@ int CDVDPlayerVideo::OutputPicture(DVDVideoPicture* pPicture, double pts)
   else
     m_iLateFrames = 0;
 
+  if (m_speed == DVD_PLAYSPEED_NORMAL && !m_stalled)
+    UpdateSkipLevel(m_iLateFrames > 0);
+
+  DVDTelemetryRecord record;
+  record.time       = iCurrentClock;
+  record.clock      = iPlayerClock;
+  record.pts        = pts;
+  record.render     = iSleepTime;
+  record.error      = pts - iPlayerClock;
+  record.dropped    = m_iDroppedFrames;
+  record.duplicated = m_iRepeatedFrames;
+  record.level      = m_messageQueue.GetLevel();
+  m_telemetry.Add(record);
+
   // ask decoder to drop frames next round, as we are very late
   if(m_iLateFrames > 10)
   {
@@ -1413,6 +1443,94 @@ void CDVDPlayerVideo::AutoCrop(DVDVideoPicture *pPicture, RECT &crop)
     crop.top = crop.bottom = min;
 }
 
+void CDVDPlayerVideo::ResetDecodeTime()
+{
+  m_fDecodeTimeSum  = 0.0;
+  m_fDecodeTimeMax  = 0.0;
+  m_iDecodeCount    = 0;
+  m_fDecodeTimeAvg  = 0.0;
+  m_fDecodeTimePeak = 0.0;
+}
+
+void CDVDPlayerVideo::AddDecodeTime(double time)
+{
+  m_fDecodeTimeSum += time;
+  m_fDecodeTimeMax  = std::max(m_fDecodeTimeMax, time);
+
+  // publish once per second of video, so the codec info shows recent values
+  if (++m_iDecodeCount >= std::max(1, (int)m_fFrameRate))
+  {
+    m_fDecodeTimeAvg  = m_fDecodeTimeSum / m_iDecodeCount;
+    m_fDecodeTimePeak = m_fDecodeTimeMax;
+    m_fDecodeTimeSum  = 0.0;
+    m_fDecodeTimeMax  = 0.0;
+    m_iDecodeCount    = 0;
+  }
+}
+
+void CDVDPlayerVideo::ResetSkipLevel()
+{
+  m_iSkipLevel      = VC_SKIP_NONE;
+  m_iSkipLevelMax   = std::max(0, std::min(g_advancedSettings.m_videoMaxSkipLevel, VC_SKIP_LEVELS - 1));
+  m_iSkipHold       = 0;
+  m_iSkipOnTime     = 0;
+  m_iSkipRecover    = 5;
+  m_iSkipSinceLower = INT_MAX;
+}
+
+void CDVDPlayerVideo::SetSkipLevel(int level)
+{
+  if (!m_pVideoCodec->SetSkipLevel(level))
+  {
+    CLog::Log(LOGDEBUG, "CDVDPlayerVideo::SetSkipLevel - %s can't skip, leaving it to frame dropping", m_codecname.c_str());
+    m_iSkipLevelMax = 0;
+    return;
+  }
+  CLog::Log(LOGDEBUG, "CDVDPlayerVideo::SetSkipLevel - level %d -> %d", m_iSkipLevel, level);
+  m_iSkipLevel = level;
+}
+
+// trade decoding quality for speed in small steps before the decoder falls so
+// far behind that whole frames have to be dropped, and give it back once the
+// decoder has kept up for a while
+void CDVDPlayerVideo::UpdateSkipLevel(bool bLate)
+{
+  m_iSkipFrames[m_iSkipLevel]++;
+
+  if (m_iSkipLevelMax == 0)
+    return;
+
+  int fps = std::max(1, (int)m_fFrameRate);
+
+  if (m_iSkipHold > 0)
+    m_iSkipHold--;
+  if (m_iSkipSinceLower < INT_MAX)
+    m_iSkipSinceLower++;
+
+  if (bLate)
+  {
+    m_iSkipOnTime = 0;
+
+    // a few late frames in a row, well before we start dropping at 10.
+    // give each step half a second to show its effect before the next one
+    if (m_iLateFrames >= 3 && m_iSkipHold == 0 && m_iSkipLevel < m_iSkipLevelMax)
+    {
+      // late again shortly after lowering, wait longer before the next try
+      if (m_iSkipSinceLower < m_iSkipRecover * fps * 2)
+        m_iSkipRecover = std::min(m_iSkipRecover * 2, 60);
+
+      SetSkipLevel(m_iSkipLevel + 1);
+      m_iSkipHold = fps / 2;
+    }
+  }
+  else if (m_iSkipLevel > VC_SKIP_NONE && ++m_iSkipOnTime >= m_iSkipRecover * fps)
+  {
+    SetSkipLevel(m_iSkipLevel - 1);
+    m_iSkipOnTime     = 0;
+    m_iSkipSinceLower = 0;
+  }
+}
+
 std::string CDVDPlayerVideo::GetPlayerInfo()
 {
   std::ostringstream s;
@@ -1421,6 +1539,12 @@ std::string CDVDPlayerVideo::GetPlayerInfo()
   s << ", dc:"   << m_codecname;
   s << ", Mb/s:" << fixed << setprecision(2) << (double)GetVideoBitrate() / (1024.0*1024.0);
   s << ", drop:" << m_iDroppedFrames;
+  if (m_fDecodeTimePeak > 0.0)
+    s << ", dec:" << fixed << setprecision(1) << m_fDecodeTimeAvg << "/" << m_fDecodeTimePeak << "ms";
+  if (m_iSkipFrames[VC_SKIP_LOOPFILTER] || m_iSkipFrames[VC_SKIP_LOOPFILTER_ALL] || m_iSkipFrames[VC_SKIP_NONREF])
+    s << ", skip:" << m_iSkipLevel << "(" << m_iSkipFrames[VC_SKIP_LOOPFILTER]
+                                   << "/" << m_iSkipFrames[VC_SKIP_LOOPFILTER_ALL]
+                                   << "/" << m_iSkipFrames[VC_SKIP_NONREF] << ")";
 
   int pc = m_pullupCorrection.GetPatternLength();
   if (pc > 0)
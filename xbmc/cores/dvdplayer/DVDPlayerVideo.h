@@ -28,6 +28,7 @@
 #include "DVDClock.h"
 #include "DVDOverlayContainer.h"
 #include "DVDTSCorrection.h"
+#include "DVDPlayerTelemetry.h"
 #ifdef HAS_VIDEO_PLAYBACK
 #include "cores/VideoRenderers/RenderManager.h"
 #endif
@@ -92,6 +93,7 @@ public:
   double GetOutputDelay(); /* returns the expected delay, from that a packet is put in queue */
   std::string GetPlayerInfo();
   int GetVideoBitrate();
+  const CDVDPlayerTelemetry& GetTelemetry() const  { return m_telemetry; }
 
   void SetSpeed(int iSpeed);
 
@@ -129,8 +131,30 @@ protected:
 
   int m_iLateFrames;
   int m_iDroppedFrames;
+  int m_iRepeatedFrames; // pictures the codec asked to show for longer, for the telemetry
   int m_iDroppedRequest;
 
+  void ResetSkipLevel();
+  void UpdateSkipLevel(bool bLate);
+  void SetSkipLevel(int level);
+
+  int m_iSkipLevel;                             //current VC_SKIP_ level of the decoder
+  int m_iSkipLevelMax;                          //highest level we may use, 0 if the codec can't skip
+  int m_iSkipHold;                              //frames to wait before raising the level again
+  int m_iSkipOnTime;                            //frames in a row that were on time
+  int m_iSkipRecover;                           //seconds on time before lowering the level
+  int m_iSkipSinceLower;                        //frames since the level was last lowered
+  unsigned int m_iSkipFrames[VC_SKIP_LEVELS];   //frames output at each level
+
+  void ResetDecodeTime();
+  void AddDecodeTime(double time);
+
+  double m_fDecodeTimeSum;   //ms spent in the decoder during the current second
+  double m_fDecodeTimeMax;
+  int    m_iDecodeCount;     //packets decoded during the current second
+  double m_fDecodeTimeAvg;   //per packet average and peak of the last complete second
+  double m_fDecodeTimePeak;
+
   void   ResetFrameRateCalc();
   void   CalcFrameRate();
 
@@ -177,6 +201,7 @@ protected:
   unsigned int m_autosync;
 
   BitstreamStats m_videoStats;
+  CDVDPlayerTelemetry m_telemetry;
 
   // classes
   CDVDStreamInfo m_hints;
@@ -0,0 +1,223 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+
+#include "AudioDecodeAhead.h"
+#include "AudioDecoder.h"
+#include "FileItem.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+CAudioDecodeAhead::CAudioDecodeAhead()
+{
+  m_active = NULL;
+  m_bufferSize = 2;
+}
+
+CAudioDecodeAhead::~CAudioDecodeAhead()
+{
+  Clear();
+}
+
+bool CAudioDecodeAhead::IsSameTrack(const CFileItem &left, const CFileItem &right)
+{
+  return left.m_strPath == right.m_strPath &&
+         left.m_lStartOffset == right.m_lStartOffset;
+}
+
+void CAudioDecodeAhead::Prepare(const std::vector<CFileItem> &items, unsigned int maxTracks, unsigned int bufferSize)
+{
+  CSingleLock lock(m_section);
+  m_bufferSize = bufferSize;
+
+  std::vector<CEntry*> entries;
+  for (unsigned int i = 0; i < items.size() && entries.size() < maxTracks; i++)
+  {
+    // keep whatever we already have for this track
+    CEntry *entry = NULL;
+    for (unsigned int j = 0; j < m_entries.size(); j++)
+    {
+      if (m_entries[j] && IsSameTrack(*m_entries[j]->item, items[i]))
+      {
+        entry = m_entries[j];
+        m_entries[j] = NULL;
+        break;
+      }
+    }
+    if (!entry)
+    {
+      entry = new CEntry;
+      entry->item = new CFileItem(items[i]);
+      entry->decoder = NULL;
+      entry->done = false;
+    }
+    entries.push_back(entry);
+  }
+  ReleaseEntries(m_entries);
+  m_entries = entries;
+
+  if (!m_entries.empty() && ThreadHandle() == NULL)
+    Create();
+  m_wake.Set();
+}
+
+CAudioDecoder *CAudioDecodeAhead::Take(const CFileItem &file)
+{
+  CSingleLock lock(m_section);
+  while (true)
+  {
+    std::vector<CEntry*>::iterator it = m_entries.begin();
+    while (it != m_entries.end() && !IsSameTrack(*(*it)->item, file))
+      ++it;
+    if (it == m_entries.end())
+      return NULL;
+
+    CEntry *entry = *it;
+    if (entry == m_active)
+    { // the worker is busy with this one - opening it ourselves wouldn't be any quicker
+      lock.Leave();
+      m_activeDone.WaitMSec(100);
+      lock.Enter();
+      continue;
+    }
+
+    m_entries.erase(it);
+    CAudioDecoder *decoder = entry->decoder;
+    delete entry->item;
+    delete entry;
+    m_wake.Set();
+    return decoder;
+  }
+}
+
+void CAudioDecodeAhead::Clear()
+{
+  m_bStop = true;
+  m_wake.Set();
+  StopThread();
+
+  CSingleLock lock(m_section);
+  ReleaseEntries(m_entries);
+  ReleaseEntries(m_released);
+}
+
+void CAudioDecodeAhead::ReleaseEntries(std::vector<CEntry*> &entries)
+{
+  std::vector<CEntry*> busy;
+  for (unsigned int i = 0; i < entries.size(); i++)
+  {
+    CEntry *entry = entries[i];
+    if (!entry)
+      continue;
+    if (entry == m_active)
+    { // the worker frees this once it's done with it
+      busy.push_back(entry);
+      continue;
+    }
+    delete entry->decoder;
+    delete entry->item;
+    delete entry;
+  }
+  entries.clear();
+  m_released.insert(m_released.end(), busy.begin(), busy.end());
+}
+
+CAudioDecodeAhead::CEntry *CAudioDecodeAhead::GetNextEntry()
+{
+  // open everything first, so a slow first track doesn't hold up the rest,
+  // then fill the buffers in playback order
+  for (unsigned int i = 0; i < m_entries.size(); i++)
+  {
+    if (!m_entries[i]->decoder && !m_entries[i]->done)
+      return m_entries[i];
+  }
+  for (unsigned int i = 0; i < m_entries.size(); i++)
+  {
+    if (!m_entries[i]->done)
+      return m_entries[i];
+  }
+  return NULL;
+}
+
+void CAudioDecodeAhead::Process()
+{
+  while (!m_bStop)
+  {
+    CEntry *entry;
+    unsigned int bufferSize;
+    {
+      CSingleLock lock(m_section);
+      ReleaseEntries(m_released);
+      entry = GetNextEntry();
+      bufferSize = m_bufferSize;
+      m_active = entry;
+    }
+
+    if (!entry)
+    {
+      m_wake.WaitMSec(1000);
+      continue;
+    }
+
+    // only this thread touches the active entry, so no need to hold the lock
+    if (!entry->decoder)
+    {
+      CAudioDecoder *decoder = new CAudioDecoder;
+      int64_t seekOffset = (entry->item->m_lStartOffset * 1000) / 75;
+      if (decoder->Create(*entry->item, seekOffset, bufferSize))
+      {
+        CLog::Log(LOGDEBUG, "%s - opened %s ahead of playback", __FUNCTION__, entry->item->m_strPath.c_str());
+        entry->decoder = decoder;
+      }
+      else
+      {
+        delete decoder;
+        entry->done = true;
+      }
+    }
+    else
+    {
+      int result = entry->decoder->ReadSamples(PACKET_SIZE);
+      if (result == RET_ERROR)
+      {
+        CLog::Log(LOGERROR, "%s - error decoding %s ahead of playback", __FUNCTION__, entry->item->m_strPath.c_str());
+        delete entry->decoder;
+        entry->decoder = NULL;
+        entry->done = true;
+      }
+      else if (result == RET_SLEEP)
+      { // buffer is full or the track is completely decoded
+        CLog::Log(LOGDEBUG, "%s - buffered %u bytes of %s", __FUNCTION__,
+                  entry->decoder->GetBufferedSize(), entry->item->m_strPath.c_str());
+        entry->done = true;
+      }
+    }
+
+    {
+      CSingleLock lock(m_section);
+      m_active = NULL;
+    }
+    m_activeDone.Set();
+  }
+
+  CSingleLock lock(m_section);
+  ReleaseEntries(m_released);
+}
@@ -0,0 +1,87 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "threads/Thread.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include <vector>
+
+class CFileItem;
+class CAudioDecoder;
+
+/*! \brief Opens and pre-decodes upcoming tracks on a background thread.
+
+ Opening a codec on a network share (CodecFactory + ICodec::Init) can take long enough
+ to starve the crossfade or gapless transition if it is only done once the current track
+ is about to end. PAPlayer hands the next few playlist entries to this stage as soon as
+ a track starts; each one is opened and decoded into its own buffer until the memory
+ budget is used up, and QueueNextFile then simply takes over the prepared decoder.
+ */
+class CAudioDecodeAhead : public CThread
+{
+public:
+  CAudioDecodeAhead();
+  virtual ~CAudioDecodeAhead();
+
+  /*! \brief Set the tracks that should be prepared, in playback order.
+   Tracks that are no longer wanted are released, new ones are opened in the background.
+   \param items the upcoming tracks - only the first maxTracks entries are used.
+   \param maxTracks the number of tracks to prepare.
+   \param bufferSize the buffer size per track (in seconds of stereo 44.1kHz audio).
+   */
+  void Prepare(const std::vector<CFileItem> &items, unsigned int maxTracks, unsigned int bufferSize);
+
+  /*! \brief Take over the prepared decoder for the given track.
+   Waits for the track to finish opening if it is being opened right now.
+   \param file the track about to be queued.
+   \return the opened decoder, owned by the caller, or NULL if the track was not prepared.
+   */
+  CAudioDecoder *Take(const CFileItem &file);
+
+  /*! \brief Release all prepared tracks and stop the background thread.
+   */
+  void Clear();
+
+protected:
+  virtual void Process();
+
+private:
+  struct CEntry
+  {
+    CFileItem     *item;
+    CAudioDecoder *decoder;
+    bool           done;    ///< buffer is full, the track has ended or failed to open
+  };
+
+  static bool IsSameTrack(const CFileItem &left, const CFileItem &right);
+  CEntry *GetNextEntry();
+  void    ReleaseEntries(std::vector<CEntry*> &entries);
+
+  std::vector<CEntry*> m_entries;
+  std::vector<CEntry*> m_released;
+  CEntry              *m_active;       ///< entry the worker is opening or decoding (outside the lock)
+  unsigned int         m_bufferSize;
+
+  CCriticalSection     m_section;
+  CEvent               m_wake;
+  CEvent               m_activeDone;
+};
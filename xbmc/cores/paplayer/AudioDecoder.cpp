@@ -28,8 +28,6 @@
 #include "utils/log.h"
 #include <math.h>
 
-#define INTERNAL_BUFFER_LENGTH  sizeof(float)*2*44100       // float samples, 2 channels, 44100 samples per sec = 1 second
-
 CAudioDecoder::CAudioDecoder()
 {
   m_codec = NULL;
@@ -107,6 +105,38 @@ bool CAudioDecoder::Create(const CFileItem &file, __int64 seekOffset, unsigned i
   return true;
 }
 
+bool CAudioDecoder::Create(CAudioDecoder &prepared, unsigned int nBufferSize)
+{
+  Destroy();
+
+  CSingleLock lock(m_critSection);
+  CSingleLock preparedLock(prepared.m_critSection);
+  if (!prepared.m_codec)
+    return false;
+
+  // keep everything that was decoded ahead, even if it is more than we'd normally buffer
+  unsigned int size = std::max<unsigned int>(2, nBufferSize) * INTERNAL_BUFFER_LENGTH;
+  unsigned int buffered = prepared.m_pcmBuffer.getMaxReadSize();
+  m_pcmBuffer.Create(std::max(size, buffered));
+  m_pcmBuffer.WriteData(prepared.m_pcmBuffer, buffered);
+  prepared.m_pcmBuffer.Destroy();
+
+  m_codec = prepared.m_codec;
+  prepared.m_codec = NULL;
+  m_blockSize = prepared.m_blockSize;
+  m_eof = prepared.m_eof;
+
+  if (prepared.m_status == STATUS_ENDING)
+    m_status = STATUS_ENDING;
+  else if (buffered > size * 0.9)
+    m_status = STATUS_QUEUED;
+  else
+    m_status = STATUS_QUEUING;
+  prepared.m_status = STATUS_NO_FILE;
+
+  return true;
+}
+
 void CAudioDecoder::GetDataFormat(unsigned int *channels, unsigned int *samplerate, unsigned int *bitspersample)
 {
   if (!m_codec)
@@ -210,17 +240,22 @@ int CAudioDecoder::ReadSamples(int numsamples)
   if ( numsamples )
   {
     int actualsamples = 0;
+    float gain = 1.0f;
+    if (g_guiSettings.m_replayGain.iType != REPLAY_GAIN_NONE)
+      gain = GetReplayGain();
+
     // if our codec sends floating point, then read it
     int result = READ_ERROR;
     if (m_codec->HasFloatData())
       result = m_codec->ReadSamples(m_inputBuffer, numsamples, &actualsamples);
     else
-      result = ReadPCMSamples(m_inputBuffer, numsamples, &actualsamples);
+      result = ReadPCMSamples(m_inputBuffer, numsamples, &actualsamples, gain);
 
     if ( result != READ_ERROR && actualsamples )
     {
-      // do any post processing of the audio (eg replaygain etc.)
-      ProcessAudio(m_inputBuffer, actualsamples);
+      // do any post processing of the audio (eg replaygain etc.) - PCM has this done while converting
+      if (m_codec->HasFloatData())
+        ProcessAudio(m_inputBuffer, actualsamples, gain);
 
       // move it into our buffer
       m_pcmBuffer.WriteData((char *)m_inputBuffer, actualsamples * sizeof(float));
@@ -259,14 +294,13 @@ int CAudioDecoder::ReadSamples(int numsamples)
   return RET_SLEEP; // nothing to do
 }
 
-void CAudioDecoder::ProcessAudio(float *data, int numsamples)
+void CAudioDecoder::ProcessAudio(float *data, int numsamples, float gain)
 {
-  if (g_guiSettings.m_replayGain.iType != REPLAY_GAIN_NONE)
+  if (gain != 1.0f)
   {
-    float gainFactor = GetReplayGain();
     for (int i = 0; i < numsamples; i++)
     {
-      data[i] *= gainFactor;
+      data[i] *= gain;
       // check the range (is this needed here?)
       if (data[i] > 1.0f) data[i] = 1.0f;
       if (data[i] < -1.0f) data[i] = -1.0f;
@@ -317,7 +351,7 @@ float CAudioDecoder::GetReplayGain()
   return replaygain;
 }
 
-int CAudioDecoder::ReadPCMSamples(float *buffer, int numsamples, int *actualsamples)
+int CAudioDecoder::ReadPCMSamples(float *buffer, int numsamples, int *actualsamples, float gain)
 {
   // convert samples to bytes
   numsamples *= (m_codec->m_BitsPerSample / 8);
@@ -331,19 +365,29 @@ int CAudioDecoder::ReadPCMSamples(float *buffer, int numsamples, int *actualsamp
   {
   case 8:
     for (i = 0; i < *actualsamples; i++)
-      m_inputBuffer[i] = 1.0f / 0x7f * (m_pcmInputBuffer[i] - 128);
+      m_inputBuffer[i] = gain / 0x7f * (m_pcmInputBuffer[i] - 128);
     break;
   case 16:
     *actualsamples /= 2;
     for (i = 0; i < *actualsamples; i++)
-      m_inputBuffer[i] = 1.0f / 0x7fff * ((short *)m_pcmInputBuffer)[i];
+      m_inputBuffer[i] = gain / 0x7fff * ((short *)m_pcmInputBuffer)[i];
     break;
   case 24:
     *actualsamples /= 3;
     for (i = 0; i < *actualsamples; i++)
-      m_inputBuffer[i] = 1.0f / 0x7fffff * (((int)m_pcmInputBuffer[3*i] << 0) | ((int)m_pcmInputBuffer[3*i+1] << 8) | (((int)((char *)m_pcmInputBuffer)[3*i+2]) << 16));
+      m_inputBuffer[i] = gain / 0x7fffff * (((int)m_pcmInputBuffer[3*i] << 0) | ((int)m_pcmInputBuffer[3*i+1] << 8) | (((int)((char *)m_pcmInputBuffer)[3*i+2]) << 16));
     break;
   }
+
+  // only amplification can take us out of range
+  if (gain > 1.0f)
+  {
+    for (i = 0; i < *actualsamples; i++)
+    {
+      if (m_inputBuffer[i] > 1.0f) m_inputBuffer[i] = 1.0f;
+      if (m_inputBuffer[i] < -1.0f) m_inputBuffer[i] = -1.0f;
+    }
+  }
   return result;
 }
 
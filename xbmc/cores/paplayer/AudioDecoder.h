@@ -38,6 +38,8 @@ class CFileItem;
 #define OUTPUT_SAMPLES PACKET_SIZE      // max number of output samples
 #define INPUT_SAMPLES  PACKET_SIZE      // number of input samples (distributed over channels)
 
+#define INTERNAL_BUFFER_LENGTH  sizeof(float)*2*44100       // float samples, 2 channels, 44100 samples per sec = 1 second
+
 #define STATUS_NO_FILE  0
 #define STATUS_QUEUING  1
 #define STATUS_QUEUED   2
@@ -57,6 +59,12 @@ public:
   ~CAudioDecoder();
 
   bool Create(const CFileItem &file, __int64 seekOffset, unsigned int nBufferSize);
+  /*! \brief Take over the codec and decoded samples of a decoder that was opened ahead of time.
+   \param prepared the decoder to take over, it is left empty.
+   \param nBufferSize the buffer size (in seconds) as for Create() - grown if prepared holds more.
+   \return true if prepared had an open codec.
+   */
+  bool Create(CAudioDecoder &prepared, unsigned int nBufferSize);
   void Destroy();
 
   int ReadSamples(int numsamples);
@@ -72,14 +80,15 @@ public:
   unsigned int GetChannels() { if (m_codec) return m_codec->m_Channels; else return 0; };
   // Data management
   unsigned int GetDataSize();
+  unsigned int GetBufferedSize() { return m_pcmBuffer.getMaxReadSize(); };
   void *GetData(unsigned int size);
   void PrefixData(void *data, unsigned int size);
   ICodec *GetCodec() const { return m_codec; }
 
 private:
-  void ProcessAudio(float *data, int numsamples);
-  // ReadPCMSamples() - helper to convert PCM (short/byte) to float
-  int ReadPCMSamples(float *buffer, int numsamples, int *actualsamples);
+  void ProcessAudio(float *data, int numsamples, float gain);
+  // ReadPCMSamples() - helper to convert PCM (short/byte) to float, applying gain in the same pass
+  int ReadPCMSamples(float *buffer, int numsamples, int *actualsamples, float gain);
   float GetReplayGain();
 
   // block size (number of bytes per sample * number of channels)
@@ -25,6 +25,8 @@
 #include "guilib/AudioContext.h"
 #include "Application.h"
 #include "FileItem.h"
+#include "PlayListPlayer.h"
+#include "playlists/PlayList.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/GUISettings.h"
 #include "settings/Settings.h"
@@ -133,6 +135,7 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
         m_decoder[m_currentDecoder].SetStatus(STATUS_ENDED);
       else //force to fade to next track immediately
         m_forceFadeToNext = true;
+      UpdateDecodeAhead(1);
     }
     return result;
   }
@@ -144,7 +147,7 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   // always open the file using the current decoder
   m_currentDecoder = 0;
 
-  if (!m_decoder[m_currentDecoder].Create(file, (__int64)(options.starttime * 1000), m_crossFading))
+  if (!CreateDecoder(m_currentDecoder, file, (__int64)(options.starttime * 1000), options.starttime == 0 && file.m_lStartOffset == 0))
     return false;
 
   m_iSpeed = 1;
@@ -180,9 +183,66 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
 
   m_decoder[m_currentDecoder].Start();  // start playback
 
+  UpdateDecodeAhead(1);
+
   return true;
 }
 
+bool PAPlayer::CreateDecoder(int decoder, const CFileItem &file, __int64 seekOffset, bool usePrepared)
+{
+  CAudioDecoder *prepared = m_decodeAhead.Take(file);
+  if (prepared)
+  {
+    bool result = usePrepared && m_decoder[decoder].Create(*prepared, m_crossFading);
+    delete prepared;
+    if (result)
+    {
+      CLog::Log(LOGDEBUG, "PAPlayer: Using decoder opened ahead for %s", file.m_strPath.c_str());
+      return true;
+    }
+  }
+  return m_decoder[decoder].Create(file, seekOffset, m_crossFading);
+}
+
+void PAPlayer::UpdateDecodeAhead(int offset)
+{
+  unsigned int tracks = g_advancedSettings.m_musicDecodeAheadTracks;
+  if (!tracks || !g_advancedSettings.m_musicDecodeAheadBuffer ||
+      g_playlistPlayer.GetCurrentPlaylist() != PLAYLIST_MUSIC)
+  {
+    m_decodeAhead.Clear();
+    return;
+  }
+
+  // grab the upcoming entries from the playlist, skipping anything that can't
+  // or shouldn't be opened next to the current track
+  std::vector<CFileItem> items;
+  const PLAYLIST::CPlayList &playlist = g_playlistPlayer.GetPlaylist(PLAYLIST_MUSIC);
+  for (unsigned int i = 0; i < tracks; i++)
+  {
+    int next = g_playlistPlayer.GetNextSong(offset + i);
+    if (next < 0 || next >= playlist.size())
+      break;
+
+    const CFileItem &item = *playlist[next];
+    if (item.IsCDDA() || item.IsLastFM() || item.IsInternetStream() ||
+        item.m_strPath == m_currentFile->m_strPath)
+      continue;
+
+    bool duplicate = false;
+    for (unsigned int j = 0; j < items.size() && !duplicate; j++)
+      duplicate = items[j].m_strPath == item.m_strPath;
+    if (!duplicate)
+      items.push_back(item);
+  }
+
+  // split the memory budget between the tracks, but buffer at least as much as QueueNextFile would
+  unsigned int bufferSize = (unsigned int)((uint64_t)g_advancedSettings.m_musicDecodeAheadBuffer * 1024 / (tracks * INTERNAL_BUFFER_LENGTH));
+  bufferSize = std::max(bufferSize, (unsigned int)std::max(2, m_crossFading));
+
+  m_decodeAhead.Prepare(items, tracks, bufferSize);
+}
+
 void PAPlayer::UpdateCrossFadingTime(const CFileItem& file)
 {
   if ((m_crossFading = g_guiSettings.GetInt("musicplayer.crossfade")))
@@ -216,7 +276,10 @@ void PAPlayer::OnNothingToQueueNotify()
 
 bool PAPlayer::QueueNextFile(const CFileItem &file)
 {
-  return QueueNextFile(file, true);
+  bool result = QueueNextFile(file, true);
+  // the file being queued is one ahead of the playlist's current song
+  UpdateDecodeAhead(2);
+  return result;
 }
 
 bool PAPlayer::QueueNextFile(const CFileItem &file, bool checkCrossFading)
@@ -235,7 +298,7 @@ bool PAPlayer::QueueNextFile(const CFileItem &file, bool checkCrossFading)
   // check if we can handle this file at all
   int decoder = 1 - m_currentDecoder;
   int64_t seekOffset = (file.m_lStartOffset * 1000) / 75;
-  if (!m_decoder[decoder].Create(file, seekOffset, m_crossFading))
+  if (!CreateDecoder(decoder, file, seekOffset, true))
   {
     m_bQueueFailed = true;
     return false;
@@ -285,6 +348,9 @@ bool PAPlayer::CloseFileInternal(bool bAudioDevice /*= true*/)
   m_visBufferLength = 0;
   StopThread();
 
+  if (bAudioDevice)
+    m_decodeAhead.Clear();
+
   // kill both our streams if we need to
   for (int i = 0; i < 2; i++)
   {
@@ -367,7 +433,8 @@ bool PAPlayer::CreateStream(int num, unsigned int channels, unsigned int sampler
   {
     FreeStream(num);
     CLog::Log(LOGDEBUG, "PAPlayer: Creating new audio renderer");
-    m_bitsPerSample[num]  = 16;
+    // hand the renderer floats if it takes them, so we never convert back to 16 bit
+    m_bitsPerSample[num]  = (g_advancedSettings.m_musicFloatOutput && CAudioRendererFactory::SupportsFloat()) ? AUDIO_BITS_FLOAT : 16;
     m_sampleRate[num]     = outputSampleRate;
     m_channelCount[num]   = channels;
     m_channelMap[num]     = NULL;
@@ -399,14 +466,14 @@ bool PAPlayer::CreateStream(int num, unsigned int channels, unsigned int sampler
   // set initial volume
   SetStreamVolume(num, g_settings.m_nVolumeLevel);
 
-  m_resampler[num].InitConverter(samplerate, bitspersample, channels, outputSampleRate, m_bitsPerSample[num], PACKET_SIZE);
+  m_resampler[num].InitConverter(samplerate, bitspersample, channels, outputSampleRate, m_bitsPerSample[num], PACKET_SIZE, m_bitsPerSample[num] == AUDIO_BITS_FLOAT);
 
   // TODO: How do we best handle the callback, given that our samplerate etc. may be
   // changing at this point?
 
-  // fire off our init to our callback  
+  // fire off our init to our callback (visualisations always get 16 bit)
   if (m_pCallback)
-    m_pCallback->OnInitialize(channels, outputSampleRate, m_bitsPerSample[num]);
+    m_pCallback->OnInitialize(channels, outputSampleRate, 16);
   return true;
 }
 
@@ -620,7 +687,7 @@ bool PAPlayer::ProcessPAP()
             {
               CLog::Log(LOGINFO, "PAPlayer: Restarting resampler due to a change in data format");
               m_resampler[m_currentStream].DeInitialize();
-              if (!m_resampler[m_currentStream].InitConverter(samplerate2, bitspersample2, channels2, g_advancedSettings.m_musicResample, 16, PACKET_SIZE))
+              if (!m_resampler[m_currentStream].InitConverter(samplerate2, bitspersample2, channels2, g_advancedSettings.m_musicResample, m_bitsPerSample[m_currentStream], PACKET_SIZE, m_bitsPerSample[m_currentStream] == AUDIO_BITS_FLOAT))
               {
                 CLog::Log(LOGERROR, "PAPlayer: Error initializing resampler!");
                 return false;
@@ -1020,7 +1087,7 @@ void PAPlayer::RegisterAudioCallback(IAudioCallback *pCallback)
 {
   m_pCallback = pCallback;
   if (m_pCallback)
-    m_pCallback->OnInitialize(m_channelCount[m_currentStream], m_sampleRate[m_currentStream], m_bitsPerSample[m_currentStream]);
+    m_pCallback->OnInitialize(m_channelCount[m_currentStream], m_sampleRate[m_currentStream], 16);
 }
 
 void PAPlayer::UnRegisterAudioCallback()
@@ -1050,9 +1117,20 @@ void PAPlayer::StreamCallback( LPVOID pPacketContext )
 
   if (m_pCallback)
   { // copy into our visualisation buffer.
-    // can't use a memcpy() here due to the context (will crash otherwise)
-    memcpy((short*)m_visBuffer, pkt->packet, pkt->length);
-    m_visBufferLength = pkt->length;
+    if (m_bitsPerSample[pkt->stream] == AUDIO_BITS_FLOAT)
+    { // visualisations only take 16 bit, so this is the one place we convert
+      const float *data = (const float *)pkt->packet;
+      unsigned int samples = pkt->length / sizeof(float);
+      for (unsigned int i = 0; i < samples; i++)
+        m_visBuffer[i] = (short)MathUtils::round_int(data[i] * 32767.0f);
+      m_visBufferLength = samples * sizeof(short);
+    }
+    else
+    {
+      // can't use a memcpy() here due to the context (will crash otherwise)
+      memcpy((short*)m_visBuffer, pkt->packet, pkt->length);
+      m_visBufferLength = pkt->length;
+    }
   }
 }
 
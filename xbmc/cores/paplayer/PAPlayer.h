@@ -24,6 +24,7 @@
 #include "cores/IPlayer.h"
 #include "threads/Thread.h"
 #include "AudioDecoder.h"
+#include "AudioDecodeAhead.h"
 #include "utils/ssrc.h"
 #include "cores/AudioRenderers/IAudioRenderer.h"
 
@@ -130,6 +131,10 @@ private:
 
   int m_currentDecoder;
   CAudioDecoder m_decoder[2]; // our 2 audiodecoders (for crossfading + precaching)
+  CAudioDecodeAhead m_decodeAhead; // opens and buffers the upcoming playlist entries
+
+  bool CreateDecoder(int decoder, const CFileItem &file, __int64 seekOffset, bool usePrepared);
+  void UpdateDecodeAhead(int offset);
 
 #ifndef _LINUX
   void SetupDirectSound(int channels);
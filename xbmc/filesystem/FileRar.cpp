@@ -41,6 +41,27 @@ using namespace std;
 
 #define SEEKTIMOUT 30000
 
+#ifdef HAS_FILESYSTEM_RAR
+static CStdString GetNameInRar(const Archive &arc)
+{
+  CStdString strFileName;
+
+  if (arc.NewLhd.FileNameW && wcslen(arc.NewLhd.FileNameW) > 0)
+  {
+    g_charsetConverter.wToUTF8(arc.NewLhd.FileNameW, strFileName);
+  }
+  else
+  {
+    g_charsetConverter.unknownToUTF8(arc.NewLhd.FileName, strFileName);
+  }
+
+  /* replace back slashes into forward slashes */
+  /* this could get us into troubles, file could two different files, one with / and one with \ */
+  strFileName.Replace('\\', '/');
+  return strFileName;
+}
+#endif
+
 #ifdef HAS_FILESYSTEM_RAR
 CFileRarExtractThread::CFileRarExtractThread()
 {
@@ -124,6 +145,8 @@ CFileRar::CFileRar()
   m_bUseFile = false;
   m_bOpen = false;
   m_bSeekable = true;
+  m_bDirect = false;
+  m_iPart = -1;
 }
 
 CFileRar::~CFileRar()
@@ -132,7 +155,9 @@ CFileRar::~CFileRar()
   if (!m_bOpen)
     return;
 
-  if (m_bUseFile)
+  if (m_bDirect)
+    m_File.Close();
+  else if (m_bUseFile)
   {
     m_File.Close();
     g_RarManager.ClearCachedFile(m_strRarPath,m_strPathInRar);
@@ -165,10 +190,18 @@ bool CFileRar::Open(const CURL& url)
   {
     if (items[i]->m_idepth == 0x30) // stored
     {
+      m_iFileSize = items[i]->m_dwSize;
+
+      // read unencrypted stored files straight from the volumes
+      if (OpenDirect())
+      {
+        m_bOpen = true;
+        return true;
+      }
+
       if (!OpenInArchive())
         return false;
 
-      m_iFileSize = items[i]->m_dwSize;
       m_bOpen = true;
 
       // perform 'noidx' check
@@ -258,6 +291,9 @@ unsigned int CFileRar::Read(void *lpBuf, int64_t uiBufSize)
   if (!m_bOpen)
     return 0;
 
+  if (m_bDirect)
+    return ReadDirect(lpBuf,uiBufSize);
+
   if (m_bUseFile)
     return m_File.Read(lpBuf,uiBufSize);
 
@@ -343,7 +379,15 @@ void CFileRar::Close()
   if (!m_bOpen)
     return;
 
-  if (m_bUseFile)
+  if (m_bDirect)
+  {
+    m_File.Close();
+    m_parts.clear();
+    m_iPart = -1;
+    m_bDirect = false;
+    m_bOpen = false;
+  }
+  else if (m_bUseFile)
   {
     m_File.Close();
     g_RarManager.ClearCachedFile(m_strRarPath,m_strPathInRar);
@@ -374,6 +418,27 @@ int64_t CFileRar::Seek(int64_t iFilePosition, int iWhence)
   if (m_bUseFile)
     return m_File.Seek(iFilePosition,iWhence);
 
+  if (m_bDirect)
+  { // reads map the position onto the volumes, so seeking is just bookkeeping
+    switch (iWhence)
+    {
+      case SEEK_CUR:
+        iFilePosition += m_iFilePosition;
+        break;
+      case SEEK_END:
+        iFilePosition += m_iFileSize;
+        break;
+      case SEEK_SET:
+        break;
+      default:
+        return -1;
+    }
+    if (iFilePosition < 0 || iFilePosition > m_iFileSize)
+      return -1;
+    m_iFilePosition = iFilePosition;
+    return m_iFilePosition;
+  }
+
   if( WaitForSingleObject(m_pExtract->GetDataIO().hBufferEmpty,SEEKTIMOUT) == WAIT_TIMEOUT )
   {
     CLog::Log(LOGERROR, "%s - Timeout waiting for buffer to empty", __FUNCTION__);
@@ -649,22 +714,7 @@ bool CFileRar::OpenInArchive()
 
     if (m_pArc->GetHeaderType() == FILE_HEAD)
     {
-      CStdString strFileName;
-
-      if (m_pArc->NewLhd.FileNameW && wcslen(m_pArc->NewLhd.FileNameW) > 0)
-      {
-        g_charsetConverter.wToUTF8(m_pArc->NewLhd.FileNameW, strFileName);
-      }
-      else
-      {
-        g_charsetConverter.unknownToUTF8(m_pArc->NewLhd.FileName, strFileName);
-      }
-
-      /* replace back slashes into forward slashes */
-      /* this could get us into troubles, file could two different files, one with / and one with \ */
-      strFileName.Replace('\\', '/');
-
-      if (strFileName == m_strPathInRar)
+      if (GetNameInRar(*m_pArc) == m_strPathInRar)
       {
         break;
       }
@@ -690,3 +740,129 @@ bool CFileRar::OpenInArchive()
 #endif
 }
 
+
+bool CFileRar::OpenDirect()
+{
+#ifdef HAS_FILESYSTEM_RAR
+  m_parts.clear();
+  m_iPart = -1;
+
+  CommandData cmd;
+  strcpy(cmd.Command, "X");
+  cmd.ParseDone();
+
+  char volume[NM];
+  strncpy(volume, m_strRarPath.c_str(), NM - 1);
+  volume[NM - 1] = 0;
+
+  // the file may be split over several volumes, each holding a stored part
+  int64_t start = 0;
+  while (true)
+  {
+    Archive arc(&cmd);
+    if (!arc.WOpen(volume, NULL) || !arc.IsArchive(true))
+      return false;
+
+    bool found = false;
+    bool splitAfter = false;
+    while (arc.ReadHeader() > 0)
+    {
+      if (arc.GetHeaderType() == FILE_HEAD && GetNameInRar(arc) == m_strPathInRar)
+      {
+        if ((arc.NewLhd.Flags & LHD_PASSWORD) || arc.NewLhd.Method != 0x30)
+          return false;
+
+        SVolumePart part;
+        part.strVolume = volume;
+        part.iOffset = arc.NextBlockPos - arc.NewLhd.FullPackSize;
+        part.iStart = start;
+        part.iSize = arc.NewLhd.FullPackSize;
+        m_parts.push_back(part);
+
+        start += part.iSize;
+        splitAfter = (arc.NewLhd.Flags & LHD_SPLIT_AFTER) != 0;
+        found = true;
+        break;
+      }
+      arc.SeekToNext();
+    }
+
+    bool oldNumbering = (arc.NewMhd.Flags & MHD_NEWNUMBERING) == 0 || arc.OldFormat;
+    bool multiVolume = arc.Volume;
+    arc.Close();
+
+    // the file may also start in a later volume of the set
+    if (!found && (!m_parts.empty() || !multiVolume))
+      return false;
+    if (found && !splitAfter)
+      break;
+
+    NextVolumeName(volume, oldNumbering);
+  }
+
+  if (start != m_iFileSize)
+  {
+    CLog::Log(LOGDEBUG, "%s - size of the parts of %s doesn't match, using the extractor", __FUNCTION__, m_strPathInRar.c_str());
+    m_parts.clear();
+    return false;
+  }
+
+  CLog::Log(LOGDEBUG, "%s - reading %s directly from %i volume(s)", __FUNCTION__, m_strPathInRar.c_str(), (int)m_parts.size());
+  m_iFilePosition = 0;
+  m_bSeekable = true;
+  m_bDirect = true;
+  return true;
+#else
+  return false;
+#endif
+}
+
+unsigned int CFileRar::ReadDirect(void* lpBuf, int64_t uiBufSize)
+{
+  byte* pBuf = (byte*)lpBuf;
+  int64_t iRead = 0;
+  while (iRead < uiBufSize && m_iFilePosition < m_iFileSize)
+  {
+    // find the part holding the current position, usually the one we're in
+    int part = m_iPart;
+    if (part < 0 || m_iFilePosition < m_parts[part].iStart ||
+        m_iFilePosition >= m_parts[part].iStart + m_parts[part].iSize)
+    {
+      for (part = 0; part < (int)m_parts.size(); part++)
+      {
+        if (m_iFilePosition < m_parts[part].iStart + m_parts[part].iSize)
+          break;
+      }
+      if (part == (int)m_parts.size())
+        break;
+
+      if (part != m_iPart)
+      {
+        m_File.Close();
+        m_iPart = -1;
+        if (!m_File.Open(m_parts[part].strVolume))
+        {
+          CLog::Log(LOGERROR, "%s - unable to open volume %s", __FUNCTION__, m_parts[part].strVolume.c_str());
+          break;
+        }
+        m_iPart = part;
+      }
+    }
+
+    const SVolumePart &current = m_parts[part];
+    int64_t iOffset = current.iOffset + m_iFilePosition - current.iStart;
+    if (m_File.GetPosition() != iOffset && m_File.Seek(iOffset, SEEK_SET) != iOffset)
+      break;
+
+    int64_t iToRead = uiBufSize - iRead;
+    if (iToRead > current.iStart + current.iSize - m_iFilePosition)
+      iToRead = current.iStart + current.iSize - m_iFilePosition;
+    unsigned int iBytes = m_File.Read(pBuf + iRead, iToRead);
+    if (iBytes == 0)
+      break;
+
+    iRead += iBytes;
+    m_iFilePosition += iBytes;
+  }
+  return (unsigned int)iRead;
+}
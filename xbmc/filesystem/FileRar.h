@@ -28,6 +28,7 @@
 #include "File.h"
 #include "UnrarXLib/rar.hpp"
 #include "threads/Thread.h"
+#include <vector>
 
 namespace XFILE
 {
@@ -87,6 +88,23 @@ namespace XFILE
     bool OpenInArchive();
     void CleanUp();
 
+    /*! \brief Locate the data of a stored file in each volume so it can be read without unrar
+     \return true if all parts were found, false if the file has to go through the extractor
+     */
+    bool OpenDirect();
+    unsigned int ReadDirect(void* lpBuf, int64_t uiBufSize);
+
+    struct SVolumePart
+    {
+      CStdString strVolume; // volume holding this part
+      int64_t iOffset;      // offset of the data in the volume
+      int64_t iStart;       // position of this part in the file
+      int64_t iSize;        // size of this part
+    };
+    std::vector<SVolumePart> m_parts;
+    int m_iPart;            // part m_File is opened on, -1 for none
+    bool m_bDirect;
+
     int64_t m_iFilePosition;
     int64_t m_iFileSize;
     // rar stuff
@@ -76,6 +76,7 @@ bool CZipManager::GetZipList(const CStdString& strPath, vector<SZipEntry>& items
       }
       mZipMap.erase(it);
       mZipDate.erase(it2);
+      mZipIndex.erase(strFile);
   }
 
   CFile mFile;
@@ -165,49 +166,67 @@ bool CZipManager::GetZipList(const CStdString& strPath, vector<SZipEntry>& items
   mFile.Read(&cdirOffset,4);
   cdirOffset = Endian_SwapLE32(cdirOffset);
 
-  // Go to the start of central directory
+  // Read the whole central directory at once, rather than entry by entry,
+  // as every read is a round trip on network shares
+  if ((int64_t)cdirOffset + cdirSize > fileSize)
+  {
+    CLog::Log(LOGDEBUG,"ZipManager: broken file %s!",strFile.c_str());
+    mFile.Close();
+    return false;
+  }
+  char *cdir = new char[cdirSize];
   mFile.Seek(cdirOffset,SEEK_SET);
+  if (mFile.Read(cdir,cdirSize) != cdirSize)
+  {
+    CLog::Log(LOGDEBUG,"ZipManager: unable to read central directory of %s!",strFile.c_str());
+    delete [] cdir;
+    mFile.Close();
+    return false;
+  }
+  mFile.Close();
 
-  char temp[CHDR_SIZE];
-  while (mFile.GetPosition() < cdirOffset + cdirSize)
+  map<CStdString,unsigned int> &index = mZipIndex[strFile];
+  index.clear();
+  items.clear();
+
+  unsigned int pos = 0;
+  while (pos < cdirSize)
   {
-    mFile.Read(temp,CHDR_SIZE);
-    readCHeader(temp, ze);
-    if (ze.header != ZIP_CENTRAL_HEADER)
+    if (pos + CHDR_SIZE > cdirSize)
+      break;
+
+    readCHeader(cdir + pos, ze);
+    if (ze.header != ZIP_CENTRAL_HEADER ||
+        pos + CHDR_SIZE + ze.flength + ze.eclength + ze.clength > cdirSize)
     {
       CLog::Log(LOGDEBUG,"ZipManager: broken file %s!",strFile.c_str());
-      mFile.Close();
+      delete [] cdir;
+      mZipIndex.erase(strFile);
+      items.clear();
       return false;
     }
+    pos += CHDR_SIZE;
 
     // Get the filename just after the central file header
-    CStdString strName;
-    mFile.Read(strName.GetBuffer(ze.flength), ze.flength);
-    strName.ReleaseBuffer();
+    CStdString strName(cdir + pos, ze.flength);
     g_charsetConverter.unknownToUTF8(strName);
     ZeroMemory(ze.name, 255);
     strncpy(ze.name, strName.c_str(), strName.size()>254 ? 254 : strName.size());
 
-    // Save the current position
-    int64_t savePos = mFile.GetPosition();
-
-    // Go to the local file header to get the extra field length
-    // !! local header extra field length != central file header extra field length !!
-    mFile.Seek(ze.lhdrOffset+28,SEEK_SET);
-    mFile.Read(&(ze.elength),2);
-    ze.elength = Endian_SwapLE16(ze.elength);
+    // The local header extra field length (which differs from the central
+    // one) is only needed to read the data, so the offset of the data is
+    // resolved when the entry is opened, see GetZipEntry
+    ze.offset = 0;
 
-    // Compressed data offset = local header offset + size of local header + filename length + local file header extra field length
-    ze.offset = ze.lhdrOffset + LHDR_SIZE + ze.flength + ze.elength;
+    // Jump after filename, central file header extra field and file comment
+    pos += ze.flength + ze.eclength + ze.clength;
 
-    // Jump after central file header extra field and file comment
-    mFile.Seek(savePos + ze.eclength + ze.clength,SEEK_SET);
-	
+    index.insert(make_pair(CStdString(ze.name), (unsigned int)items.size()));
     items.push_back(ze);
   }
+  delete [] cdir;
 
   mZipMap.insert(make_pair(strFile,items));
-  mFile.Close();
   return true;
 }
 
@@ -218,26 +237,42 @@ bool CZipManager::GetZipEntry(const CStdString& strPath, SZipEntry& item)
   CStdString strFile = url.GetHostName();
 
   map<CStdString,vector<SZipEntry> >::iterator it = mZipMap.find(strFile);
-  vector<SZipEntry> items;
   if (it == mZipMap.end()) // we need to list the zip
   {
-    GetZipList(strPath,items);
-  }
-  else
-  {
-    items = it->second;
+    vector<SZipEntry> items;
+    if (!GetZipList(strPath,items))
+      return false;
+    it = mZipMap.find(strFile);
+    if (it == mZipMap.end())
+      return false;
   }
 
-  CStdString strFileName = url.GetFileName();
-  for (vector<SZipEntry>::iterator it2=items.begin();it2 != items.end();++it2)
-  {
-    if (CStdString(it2->name) == strFileName)
-    {
-      memcpy(&item,&(*it2),sizeof(SZipEntry));
-      return true;
-    }
+  map<CStdString,map<CStdString,unsigned int> >::iterator index = mZipIndex.find(strFile);
+  if (index == mZipIndex.end())
+    return false;
+
+  map<CStdString,unsigned int>::iterator entry = index->second.find(url.GetFileName());
+  if (entry == index->second.end() || entry->second >= it->second.size())
+    return false;
+
+  SZipEntry &ze = it->second[entry->second];
+  if (!ze.offset)
+  { // Go to the local file header to get the extra field length
+    // !! local header extra field length != central file header extra field length !!
+    CFile mFile;
+    if (!mFile.Open(strFile))
+      return false;
+    mFile.Seek(ze.lhdrOffset+28,SEEK_SET);
+    if (mFile.Read(&(ze.elength),2) != 2)
+      return false;
+    ze.elength = Endian_SwapLE16(ze.elength);
+
+    // Compressed data offset = local header offset + size of local header + filename length + local file header extra field length
+    ze.offset = ze.lhdrOffset + LHDR_SIZE + ze.flength + ze.elength;
   }
-  return false;
+
+  memcpy(&item,&ze,sizeof(SZipEntry));
+  return true;
 }
 
 bool CZipManager::ExtractArchive(const CStdString& strArchive, const CStdString& strPath)
@@ -323,6 +358,7 @@ void CZipManager::release(const CStdString& strPath)
     map<CStdString,int64_t>::iterator it2=mZipDate.find(url.GetHostName());
     mZipMap.erase(it);
     mZipDate.erase(it2);
+    mZipIndex.erase(url.GetHostName());
   }
 }
 
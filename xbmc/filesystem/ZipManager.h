@@ -111,6 +111,7 @@ public:
 private:
   std::map<CStdString,std::vector<SZipEntry> > mZipMap;
   std::map<CStdString,int64_t> mZipDate;
+  std::map<CStdString,std::map<CStdString,unsigned int> > mZipIndex; // entry name -> position in mZipMap, per archive
 };
 
 extern CZipManager g_ZipManager;
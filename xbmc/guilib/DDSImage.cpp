@@ -24,9 +24,12 @@
 #include "libsquish/squish.h"
 #include "utils/log.h"
 #include <string.h>
+#include <algorithm>
+#include <vector>
 
 #ifndef NO_XBMC_FILESYSTEM
 #include "filesystem/File.h"
+#include "threads/Thread.h"
 using namespace XFILE;
 #else
 #include "SimpleFS.h"
@@ -34,6 +37,40 @@ using namespace XFILE;
 
 using namespace std;
 
+// minimal number of block rows (4 pixel rows each) per strip, smaller images aren't worth a thread
+#define MIN_BLOCK_ROWS_PER_STRIP 16
+
+namespace
+{
+  /* compresses a strip of whole block rows and computes its error */
+  class CCompressStrip
+#ifndef NO_XBMC_FILESYSTEM
+    : public IRunnable
+#endif
+  {
+  public:
+    CCompressStrip(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb, unsigned char *dxt, int flags)
+      : m_width(width), m_height(height), m_pitch(pitch), m_argb(argb), m_dxt(dxt), m_flags(flags), m_colorMSE(0), m_alphaMSE(0)
+    {
+    }
+
+    virtual void Run()
+    {
+      squish::CompressImage(m_argb, m_width, m_height, m_pitch, m_dxt, m_flags);
+      squish::ComputeMSE(m_argb, m_width, m_height, m_pitch, m_dxt, m_flags, m_colorMSE, m_alphaMSE);
+    }
+
+    unsigned int         m_width;
+    unsigned int         m_height;
+    unsigned int         m_pitch;
+    unsigned char const *m_argb;
+    unsigned char       *m_dxt;
+    int                  m_flags;
+    double               m_colorMSE;
+    double               m_alphaMSE;
+  };
+}
+
 CDDSImage::CDDSImage()
 {
   m_data = NULL;
@@ -118,9 +155,9 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
-bool CDDSImage::Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, double maxMSE)
+bool CDDSImage::Create(const std::string &outputFile, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, double maxMSE, unsigned int threads, bool fast)
 {
-  if (!Compress(width, height, pitch, brga, maxMSE))
+  if (!Compress(width, height, pitch, brga, maxMSE, threads, fast))
   { // use ARGB
     Allocate(width, height, XB_FMT_A8R8G8B8);
     for (unsigned int i = 0; i < height; i++)
@@ -160,16 +197,17 @@ unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int
   }
 }
 
-bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, double maxMSE)
+bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga, double maxMSE, unsigned int threads, bool fast)
 {
+  int flags = squish::kSourceBGRA | (fast ? squish::kColourRangeFit : squish::kColourClusterFit);
+
   // first try DXT1, which is only 4bits/pixel
   Allocate(width, height, XB_FMT_DXT1);
 
-  squish::CompressImage(brga, width, height, pitch, m_data, squish::kDxt1 | squish::kSourceBGRA);
   const char *fourCC = NULL;
 
   double colorMSE, alphaMSE;
-  squish::ComputeMSE(brga, width, height, pitch, m_data, squish::kDxt1 | squish::kSourceBGRA, colorMSE, alphaMSE);
+  CompressImage(width, height, pitch, brga, m_data, squish::kDxt1 | flags, threads, colorMSE, alphaMSE);
   if (!maxMSE || (colorMSE < maxMSE && alphaMSE < maxMSE))
     fourCC = "DXT1";
   else
@@ -188,14 +226,12 @@ bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int p
     if (alphaMSE > 0)
     { // try DXT3 and DXT5 - use whichever is better (color is the same as DXT1, but alpha will be different)
       Allocate(width, height, XB_FMT_DXT3);
-      squish::CompressImage(brga, width, height, pitch, m_data, squish::kDxt3 | squish::kSourceBGRA);
-      squish::ComputeMSE(brga, width, height, pitch, m_data, squish::kDxt3 | squish::kSourceBGRA, colorMSE, alphaMSE);
+      CompressImage(width, height, pitch, brga, m_data, squish::kDxt3 | flags, threads, colorMSE, alphaMSE);
       if (colorMSE < maxMSE)
       { // color is fine, test DXT5 as well
         double dxt5MSE;
         unsigned char *data2 = new unsigned char[GetStorageRequirements(width, height, XB_FMT_DXT5)];
-        squish::CompressImage(brga, width, height, pitch, data2, squish::kDxt5 | squish::kSourceBGRA);
-        squish::ComputeMSE(brga, width, height, pitch, data2, squish::kDxt5 | squish::kSourceBGRA, colorMSE, dxt5MSE);
+        CompressImage(width, height, pitch, brga, data2, squish::kDxt5 | flags, threads, colorMSE, dxt5MSE);
         if (alphaMSE < maxMSE && alphaMSE < dxt5MSE)
           fourCC = "DXT3";
         else if (dxt5MSE < maxMSE)
@@ -218,6 +254,61 @@ bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int p
   return false;
 }
 
+void CDDSImage::CompressImage(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *brga,
+                              unsigned char *dxt, int flags, unsigned int threads, double &colorMSE, double &alphaMSE)
+{
+  colorMSE = alphaMSE = 0;
+  if (!width || !height)
+    return;
+
+  // DXT blocks are 4x4 pixels, so strips are split on block rows and each
+  // strip's output is a contiguous range of blocks
+  unsigned int blockRows = (height + 3) / 4;
+  unsigned int blockRowSize = ((width + 3) / 4) * ((flags & squish::kDxt1) ? 8 : 16);
+
+  unsigned int strips = std::max(1U, std::min(threads, blockRows / MIN_BLOCK_ROWS_PER_STRIP));
+#ifdef NO_XBMC_FILESYSTEM
+  strips = 1;
+#endif
+  unsigned int rowsPerStrip = (blockRows + strips - 1) / strips;
+
+  vector<CCompressStrip> work;
+  for (unsigned int row = 0; row < blockRows; row += rowsPerStrip)
+  {
+    unsigned int y = row * 4;
+    unsigned int rows = std::min(rowsPerStrip * 4, height - y);
+    work.push_back(CCompressStrip(width, rows, pitch, brga + y * pitch, dxt + row * blockRowSize, flags));
+  }
+
+#ifndef NO_XBMC_FILESYSTEM
+  // the calling thread takes the first strip itself
+  vector<CThread *> workers;
+  for (unsigned int i = 1; i < work.size(); i++)
+  {
+    CThread *thread = new CThread(&work[i], "DDSCompressStrip");
+    thread->Create();
+    workers.push_back(thread);
+  }
+#endif
+  work[0].Run();
+#ifndef NO_XBMC_FILESYSTEM
+  for (unsigned int i = 0; i < workers.size(); i++)
+  {
+    workers[i]->StopThread();
+    delete workers[i];
+  }
+#endif
+
+  // the error is a mean over the pixels, so weight each strip by its height
+  for (unsigned int i = 0; i < work.size(); i++)
+  {
+    colorMSE += work[i].m_colorMSE * work[i].m_height;
+    alphaMSE += work[i].m_alphaMSE * work[i].m_height;
+  }
+  colorMSE /= height;
+  alphaMSE /= height;
+}
+
 bool CDDSImage::Decompress(unsigned char *argb, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *dxt, unsigned int format)
 {
   if (!argb || !dxt || !(format & XB_FMT_DXT_MASK))
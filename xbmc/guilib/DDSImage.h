@@ -46,9 +46,11 @@ public:
    \param pitch pitch of the pixel buffer
    \param argb pixel buffer
    \param maxMSE maximum mean square error to allow, ignored if 0 (the default)
+   \param threads number of threads to compress with, the image is split into horizontal strips
+   \param fast use the fast (range fit) rather than the high quality (cluster fit) compressor
    \return true on successful image creation, false otherwise
    */
-  bool Create(const std::string &file, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb, double maxMSE = 0);
+  bool Create(const std::string &file, unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb, double maxMSE = 0, unsigned int threads = 1, bool fast = false);
   
   /*! \brief Decompress a DXT1/3/5 image to the given buffer
    Assumes the buffer has been allocated to at least width*height*4
@@ -73,9 +75,26 @@ private:
    \param pitch pitch of the pixel buffer
    \param argb pixel buffer
    \param maxMSE maximum mean square error to allow, ignored if 0 (the default)
+   \param threads number of threads to compress with
+   \param fast use the fast (range fit) rather than the high quality (cluster fit) compressor
    \return true on successful compression within the given maxMSE, false otherwise
    */
-  bool Compress(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb, double maxMSE = 0);
+  bool Compress(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb, double maxMSE = 0, unsigned int threads = 1, bool fast = false);
+
+  /*! \brief Compress an ARGB buffer with libsquish and compute the resulting error
+   Splits the image into strips of whole block rows which are compressed in parallel.
+   \param width width of the pixel buffer
+   \param height height of the pixel buffer
+   \param pitch pitch of the pixel buffer
+   \param argb pixel buffer
+   \param dxt buffer to compress into, at least GetStorageRequirements() bytes
+   \param flags libsquish flags
+   \param threads maximal number of threads to use
+   \param colorMSE [out] mean square error of the color channels
+   \param alphaMSE [out] mean square error of the alpha channel
+   */
+  static void CompressImage(unsigned int width, unsigned int height, unsigned int pitch, unsigned char const *argb,
+                            unsigned char *dxt, int flags, unsigned int threads, double &colorMSE, double &alphaMSE);
 
   unsigned int GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format) const;
   enum {
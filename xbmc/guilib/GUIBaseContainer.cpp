@@ -58,6 +58,9 @@ CGUIBaseContainer::CGUIBaseContainer(int parentID, int controlID, float posX, fl
   m_layout = NULL;
   m_focusedLayout = NULL;
   m_cacheItems = preloadItems;
+  m_fetchProvider = NULL;
+  m_fetchOffset = 0;
+  m_fetchDirection = 1;
 }
 
 CGUIBaseContainer::~CGUIBaseContainer(void)
@@ -93,6 +96,9 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
+  // and have the items on screen and a page either side filled in
+  FetchItems(offset, cacheBefore, cacheAfter);
+
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
   float pos = (m_orientation == VERTICAL) ? origin.y : origin.x;
   float end = (m_orientation == VERTICAL) ? m_posY + m_height : m_posX + m_width;
@@ -371,6 +377,7 @@ bool CGUIBaseContainer::OnMessage(CGUIMessage& message)
         CFileItemList *items = (CFileItemList *)message.GetPointer();
         for (int i = 0; i < items->Size(); i++)
           m_items.push_back(items->Get(i));
+        m_provider = items->GetProviderLink();
         UpdateLayout(true); // true to refresh all items
         UpdateScrollByLetter();
         SelectItem(message.GetParam1());
@@ -963,6 +970,8 @@ void CGUIBaseContainer::Reset()
   m_wasReset = true;
   m_items.clear();
   m_lastItem = NULL;
+  m_provider.reset();
+  m_fetchProvider = NULL;
 }
 
 void CGUIBaseContainer::LoadLayout(TiXmlElement *layout)
@@ -1025,6 +1034,51 @@ void CGUIBaseContainer::SetType(VIEW_TYPE type, const CStdString &label)
   m_label = label;
 }
 
+void CGUIBaseContainer::FetchItems(int offset, int cacheBefore, int cacheAfter)
+{
+  IListItemProvider *provider = m_provider ? m_provider->Get() : NULL;
+  if (!provider || m_items.empty())
+    return;
+  if (provider == m_fetchProvider && offset == m_fetchOffset)
+    return;
+
+  // fetch ahead in the direction we last moved
+  if (provider == m_fetchProvider)
+    m_fetchDirection = offset > m_fetchOffset ? 1 : -1;
+  m_fetchProvider = provider;
+  m_fetchOffset = offset;
+
+  int first = offset - cacheBefore;
+  int last = offset + m_itemsPerPage + cacheAfter;
+  vector<CGUIListItemPtr> items;
+  GetItemsInRows(items, first, last);
+  unsigned int visible = items.size();
+  if (m_fetchDirection > 0)
+  {
+    GetItemsInRows(items, last + 1, last + m_itemsPerPage);
+    GetItemsInRows(items, first - m_itemsPerPage, first - 1);
+  }
+  else
+  {
+    GetItemsInRows(items, first - m_itemsPerPage, first - 1);
+    GetItemsInRows(items, last + 1, last + m_itemsPerPage);
+  }
+  if (!items.empty())
+    provider->FetchItems(items, visible);
+}
+
+void CGUIBaseContainer::GetItemsInRows(vector<CGUIListItemPtr> &items, int firstRow, int lastRow) const
+{
+  for (int row = firstRow; row <= lastRow; ++row)
+  {
+    int itemNo = CorrectOffset(row, 0);
+    int next = CorrectOffset(row + 1, 0);
+    int end = next > itemNo ? next : itemNo + 1; // wrapping lists go back to 0
+    for (int i = max(itemNo, 0); i < end && i < (int)m_items.size(); ++i)
+      items.push_back(m_items[i]);
+  }
+}
+
 void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
 {
   if (keepStart < keepEnd)
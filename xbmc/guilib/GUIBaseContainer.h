@@ -28,6 +28,7 @@
 
 #include "GUIControl.h"
 #include "GUIListItemLayout.h"
+#include "IListItemProvider.h"
 #include "boost/shared_ptr.hpp"
 #include "utils/Stopwatch.h"
 
@@ -124,6 +125,12 @@ protected:
   inline float Size() const;
   void MoveToRow(int row);
   void FreeMemory(int keepStart, int keepEnd);
+  /*! \brief Ask the provider of our items to fill in those on screen, then a page ahead and a page behind
+   Ahead is the direction we last scrolled in.  Does nothing if the offset and provider are unchanged.
+   \param offset first row on screen
+   \param cacheBefore, cacheAfter rows kept either side of the screen, as from GetCacheOffsets
+   */
+  void FetchItems(int offset, int cacheBefore, int cacheAfter);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -161,6 +168,7 @@ protected:
   bool m_staticContent;
   unsigned int m_staticUpdateTime;
   std::vector<CGUIListItemPtr> m_staticItems;
+  CListItemProviderLinkPtr m_provider; ///< \brief fills in our bound items as they come near the screen
   bool m_wasReset;  // true if we've received a Reset message until we've rendered once.  Allows
                     // us to make sure we don't tell the infomanager that we've been moving when
                     // the "movement" was simply due to the list being repopulated (thus cursor position
@@ -191,9 +199,14 @@ protected:
   inline int GetOffset() const { return m_offset; };
 
 private:
+  void GetItemsInRows(std::vector<CGUIListItemPtr> &items, int firstRow, int lastRow) const;
+
   int m_cursor;
   int m_offset;
   int m_cacheItems;
+  IListItemProvider *m_fetchProvider;
+  int m_fetchOffset;
+  int m_fetchDirection;
   float m_scrollSpeed;
   CStopWatch m_scrollTimer;
   CStopWatch m_pageChangeTimer;
@@ -354,5 +354,40 @@ bool CGUIControlProfiler::SaveResults(void)
   doc.LinkEndChild(root);
 
   m_ItemHead.SaveToXML(root);
+
+  TiXmlElement *windows = new TiXmlElement("windowloads");
+  for (std::map<int, WindowLoad>::const_iterator it = m_windowLoads.begin(); it != m_windowLoads.end(); ++it)
+  {
+    const WindowLoad &load = it->second;
+    TiXmlElement *window = new TiXmlElement("window");
+    window->SetAttribute("id", it->first);
+    window->SetAttribute("file", load.skinFile.c_str());
+    window->SetAttribute("source", load.source.c_str());
+    window->SetAttribute("loads", load.loads);
+    str.Format("%.2f", load.lastTime);
+    window->SetAttribute("lasttime", str.c_str());
+    str.Format("%.2f", load.totalTime / load.loads);
+    window->SetAttribute("averagetime", str.c_str());
+    window->SetAttribute("memorykb", load.size / 1024);
+    windows->LinkEndChild(window);
+  }
+  root->LinkEndChild(windows);
+
   return doc.SaveFile(m_strOutputFile);
 }
+
+void CGUIControlProfiler::AddWindowLoad(int windowID, const CStdString &skinFile, const char *source, float loadTime, unsigned int size)
+{
+  WindowLoad &load = m_windowLoads[windowID];
+  if (load.skinFile != skinFile)
+  {
+    load.skinFile  = skinFile;
+    load.loads     = 0;
+    load.totalTime = 0.0f;
+  }
+  load.source    = source;
+  load.lastTime  = loadTime;
+  load.totalTime += loadTime;
+  load.size      = size;
+  load.loads++;
+}
@@ -25,6 +25,8 @@
 
 #include "GUIControl.h"
 
+#include <map>
+
 class CGUIControlProfiler;
 class TiXmlElement;
 
@@ -75,6 +77,15 @@ public:
   void SetOutputFile(const CStdString &strOutputFile) { m_strOutputFile = strOutputFile; };
   const CStdString &GetOutputFile(void) const { return m_strOutputFile; };
   bool SaveResults(void);
+
+  /*! \brief Record the load of a window, written along with the control results.
+   \param windowID the id of the window
+   \param skinFile the skin file the window was loaded from
+   \param source where the skin xml came from, ie preload, cache or file
+   \param loadTime time taken to load and build the window in ms
+   \param size estimated memory held by the window's skin xml in bytes
+   */
+  void AddWindowLoad(int windowID, const CStdString &skinFile, const char *source, float loadTime, unsigned int size);
   unsigned int GetTotalTime(void) const { return m_ItemHead.GetTotalTime(); };
 
   float m_fPerfScale;
@@ -88,6 +99,17 @@ private:
   CGUIControlProfilerItem *m_pLastItem;
   CGUIControlProfilerItem *FindOrAddControl(CGUIControl *pControl);
 
+  typedef struct
+  {
+    CStdString   skinFile;
+    CStdString   source;
+    unsigned int loads;
+    float        lastTime;
+    float        totalTime;
+    unsigned int size;
+  } WindowLoad;
+  std::map<int, WindowLoad> m_windowLoads;
+
   static bool m_bIsRunning;
   CStdString m_strOutputFile;
   int m_iMaxFrameCount;
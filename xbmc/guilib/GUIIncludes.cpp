@@ -30,6 +30,7 @@ using namespace std;
 
 CGUIIncludes::CGUIIncludes()
 {
+  m_conditions = NULL;
   m_constantAttributes.insert("x");
   m_constantAttributes.insert("y");
   m_constantAttributes.insert("width");
@@ -161,7 +162,14 @@ bool CGUIIncludes::HasIncludeFile(const CStdString &file) const
   return false;
 }
 
-void CGUIIncludes::ResolveIncludes(TiXmlElement *node)
+void CGUIIncludes::ResolveIncludes(TiXmlElement *node, std::map<CStdString, bool> *conditions)
+{
+  m_conditions = conditions;
+  ResolveIncludesForElement(node);
+  m_conditions = NULL;
+}
+
+void CGUIIncludes::ResolveIncludesForElement(TiXmlElement *node)
 {
   if (!node)
     return;
@@ -170,7 +178,7 @@ void CGUIIncludes::ResolveIncludes(TiXmlElement *node)
   TiXmlElement *child = node->FirstChildElement();
   while (child)
   {
-    ResolveIncludes(child);
+    ResolveIncludesForElement(child);
     child = child->NextSiblingElement();
   }
 }
@@ -212,7 +220,10 @@ void CGUIIncludes::ResolveIncludesForNode(TiXmlElement *node)
     const char *condition = include->Attribute("condition");
     if (condition)
     { // check this condition
-      if (!g_infoManager.GetBool(g_infoManager.TranslateString(condition)))
+      bool value = g_infoManager.GetBool(g_infoManager.TranslateString(condition));
+      if (m_conditions)
+        (*m_conditions)[condition] = value;
+      if (!value)
       {
         include = include->NextSiblingElement("include");
         continue;
@@ -43,10 +43,16 @@ public:
    Replaces any instances of <include file="foo">bar</include> with the value of the include
    "bar" from the include file "foo".
    \param node an XML Element - all child elements are traversed.
+   \param conditions [out] if non-NULL, receives the include conditions evaluated while resolving, with their results.
    */
-  void ResolveIncludes(TiXmlElement *node);
+  void ResolveIncludes(TiXmlElement *node, std::map<CStdString, bool> *conditions = NULL);
+
+  /*! \brief The include files loaded so far
+   */
+  const std::vector<CStdString> &GetFiles() const { return m_files; };
 
 private:
+  void ResolveIncludesForElement(TiXmlElement *node);
   void ResolveIncludesForNode(TiXmlElement *node);
   CStdString ResolveConstant(const CStdString &constant) const;
   bool HasIncludeFile(const CStdString &includeFile) const;
@@ -58,5 +64,7 @@ private:
 
   std::set<std::string> m_constantAttributes;
   std::set<std::string> m_constantNodes;
+
+  std::map<CStdString, bool> *m_conditions;
 };
 
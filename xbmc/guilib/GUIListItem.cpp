@@ -25,6 +25,8 @@
 #include "utils/CharsetConverter.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
+
 CGUIListItem::CGUIListItem(const CGUIListItem& item)
 {
   m_layout = NULL;
@@ -44,11 +46,13 @@ CGUIListItem::CGUIListItem(void)
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_layout = NULL;
   m_focusedLayout = NULL;
+  m_sortKeyId = 0;
 }
 
 CGUIListItem::CGUIListItem(const CStdString& strLabel)
 {
   m_bIsFolder = false;
+  m_sortKeyId = 0;
   m_strLabel2 = "";
   m_strLabel = strLabel;
   SetSortLabel(strLabel);
@@ -72,6 +76,7 @@ void CGUIListItem::SetLabel(const CStdString& strLabel)
   m_strLabel = strLabel;
   if (m_sortLabel.IsEmpty())
     SetSortLabel(strLabel);
+  ClearSortKey();
   SetInvalid();
 }
 
@@ -97,6 +102,7 @@ const CStdString& CGUIListItem::GetLabel2() const
 void CGUIListItem::SetSortLabel(const CStdString &label)
 {
   g_charsetConverter.utf8ToW(label, m_sortLabel, false);
+  ClearSortKey();
   // no need to invalidate - this is never shown in the UI
 }
 
@@ -105,6 +111,18 @@ const CStdStringW& CGUIListItem::GetSortLabel() const
   return m_sortLabel;
 }
 
+void CGUIListItem::SetSortKey(const std::string &key, int id)
+{
+  m_sortKey = key;
+  m_sortKeyId = id;
+}
+
+void CGUIListItem::ClearSortKey()
+{
+  m_sortKey.clear();
+  m_sortKeyId = 0;
+}
+
 void CGUIListItem::SetThumbnailImage(const CStdString& strThumbnail)
 {
   if (m_strThumbnailImage == strThumbnail)
@@ -197,6 +215,8 @@ const CGUIListItem& CGUIListItem::operator =(const CGUIListItem& item)
   m_strLabel2 = item.m_strLabel2;
   m_strLabel = item.m_strLabel;
   m_sortLabel = item.m_sortLabel;
+  m_sortKey = item.m_sortKey;
+  m_sortKeyId = item.m_sortKeyId;
   FreeMemory();
   m_bSelected = item.m_bSelected;
   m_strIcon = item.m_strIcon;
@@ -221,10 +241,10 @@ void CGUIListItem::Archive(CArchive &ar)
     ar << m_bSelected;
     ar << m_overlayIcon;
     ar << (int)m_mapProperties.size();
-    for (std::map<CStdString, CStdString, icompare>::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); it++)
+    for (PropertyMap::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); it++)
     {
-      ar << it->first;
-      ar << it->second;
+      ar << it->first.Get();
+      ar << it->second.Get();
     }
   }
   else
@@ -233,6 +253,7 @@ void CGUIListItem::Archive(CArchive &ar)
     ar >> m_strLabel;
     ar >> m_strLabel2;
     ar >> m_sortLabel;
+    ClearSortKey();
     ar >> m_strThumbnailImage;
     ar >> m_strIcon;
     ar >> m_bSelected;
@@ -262,9 +283,9 @@ void CGUIListItem::Serialize(CVariant &value)
   value["strIcon"] = m_strIcon;
   value["selected"] = m_bSelected;
 
-  for (std::map<CStdString, CStdString, icompare>::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); it++)
+  for (PropertyMap::const_iterator it = m_mapProperties.begin(); it != m_mapProperties.end(); it++)
   {
-    value["properties"][it->first] = it->second;
+    value["properties"][it->first.Get()] = it->second.Get();
   }
 }
 
@@ -320,37 +341,53 @@ void CGUIListItem::SetInvalid()
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
 }
 
+CGUIListItem::PropertyMap::iterator CGUIListItem::FindProperty(const CStdString &strKey)
+{
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, icompare());
+  if (iter != m_mapProperties.end() && iter->first.Get().CompareNoCase(strKey) == 0)
+    return iter;
+  return m_mapProperties.end();
+}
+
+CGUIListItem::PropertyMap::const_iterator CGUIListItem::FindProperty(const CStdString &strKey) const
+{
+  PropertyMap::const_iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, icompare());
+  if (iter != m_mapProperties.end() && iter->first.Get().CompareNoCase(strKey) == 0)
+    return iter;
+  return m_mapProperties.end();
+}
+
 void CGUIListItem::SetProperty(const CStdString &strKey, const char *strValue)
 {
-  m_mapProperties[strKey] = strValue;
+  SetProperty(strKey, CStdString(strValue));
 }
 
 void CGUIListItem::SetProperty(const CStdString &strKey, const CStdString &strValue)
 {
-  m_mapProperties[strKey] = strValue;
+  PropertyMap::iterator iter = std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey, icompare());
+  if (iter != m_mapProperties.end() && iter->first.Get().CompareNoCase(strKey) == 0)
+    iter->second = strValue;
+  else
+    m_mapProperties.insert(iter, Property(strKey, strValue));
 }
 
 CStdString CGUIListItem::GetProperty(const CStdString &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   if (iter == m_mapProperties.end())
     return "";
 
-  return iter->second;
+  return iter->second.Get();
 }
 
 bool CGUIListItem::HasProperty(const CStdString &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
-    return false;
-
-  return true;
+  return FindProperty(strKey) != m_mapProperties.end();
 }
 
 void CGUIListItem::ClearProperty(const CStdString &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::iterator iter = FindProperty(strKey);
   if (iter != m_mapProperties.end())
     m_mapProperties.erase(iter);
 }
@@ -411,5 +448,5 @@ double CGUIListItem::GetPropertyDouble(const CStdString &strKey) const
 void CGUIListItem::AppendProperties(const CGUIListItem &item)
 {
   for (PropertyMap::const_iterator i = item.m_mapProperties.begin(); i != item.m_mapProperties.end(); ++i)
-    SetProperty(i->first, i->second);
+    SetProperty(i->first.Get(), i->second.Get());
 }
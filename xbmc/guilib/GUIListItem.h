@@ -30,9 +30,11 @@
  */
 
 #include "utils/StdString.h"
+#include "utils/InternedString.h"
 
 #include <map>
 #include <string>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -82,6 +84,16 @@ public:
   void SetSortLabel(const CStdString &label);
   const CStdStringW &GetSortLabel() const;
 
+  /*! \brief Cache a binary key built from the sort label, see StringUtils::AlphaNumericSortKey.
+   The key is dropped whenever the label or sort label changes.
+   \param key the key
+   \param id nonzero identifier of how the sort label was filled, eg the sort method
+   */
+  void SetSortKey(const std::string &key, int id);
+  const std::string &GetSortKey() const { return m_sortKey; };
+  bool HasSortKey(int id) const { return m_sortKeyId == id; };
+  void ClearSortKey();
+
   void Select(bool bOnOff);
   bool IsSelected() const;
 
@@ -142,18 +154,34 @@ protected:
   CGUIListItemLayout *m_focusedLayout;
   bool m_bSelected;     // item is selected or not
 
+  /* properties are kept sorted on their case insensitive name. Names and values are
+     interned, as the same names and often the same values are set on every item of a list */
+  typedef std::pair<CInternedString, CInternedString> Property;
+  typedef std::vector<Property> PropertyMap;
+  PropertyMap m_mapProperties;
+
   struct icompare
   {
-    bool operator()(const CStdString &s1, const CStdString &s2) const
+    bool operator()(const Property &p, const CStdString &key) const
+    {
+      return p.first.Get().CompareNoCase(key) < 0;
+    }
+    bool operator()(const CStdString &key, const Property &p) const
+    {
+      return key.CompareNoCase(p.first.Get()) < 0;
+    }
+    bool operator()(const Property &p1, const Property &p2) const
     {
-      return s1.CompareNoCase(s2) < 0;
+      return p1.first.Get().CompareNoCase(p2.first.Get()) < 0;
     }
   };
-  
-  typedef std::map<CStdString, CStdString, icompare> PropertyMap;
-  PropertyMap m_mapProperties;
+
+  PropertyMap::iterator FindProperty(const CStdString &strKey);
+  PropertyMap::const_iterator FindProperty(const CStdString &strKey) const;
 private:
   CStdStringW m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
+  std::string m_sortKey;      // m_sortLabel as a key for bytewise comparison
+  int m_sortKeyId;            // what m_sortKey was built for, 0 if it isn't valid
   CStdString m_strLabel;      // text of column1
 };
 #endif
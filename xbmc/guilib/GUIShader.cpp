@@ -72,8 +72,8 @@ bool CGUIShader::OnEnabled()
 {
   // This is called after glUseProgram()
 
-  glUniformMatrix4fv(m_hProj,  1, GL_FALSE, g_matrices.GetMatrix(MM_PROJECTION));
-  glUniformMatrix4fv(m_hModel, 1, GL_FALSE, g_matrices.GetMatrix(MM_MODELVIEW));
+  SetUniformMatrix4fv(m_hProj,  g_matrices.GetMatrix(MM_PROJECTION));
+  SetUniformMatrix4fv(m_hModel, g_matrices.GetMatrix(MM_MODELVIEW));
 
   return true;
 }
@@ -0,0 +1,405 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "GUISkinCache.h"
+#include "GUIInfoManager.h"
+#include "filesystem/File.h"
+#include "tinyXML/tinyxml.h"
+#include "utils/Crc32.h"
+#include "utils/log.h"
+
+#include <string.h>
+
+using namespace std;
+using namespace XFILE;
+
+// bump whenever the layout below changes
+#define SKIN_CACHE_MAGIC   "XBMCSKC"
+#define SKIN_CACHE_VERSION 1
+
+// nodes nested deeper than this mean a broken cache file
+#define SKIN_CACHE_MAX_DEPTH 256
+
+enum { NODE_ELEMENT = 1, NODE_TEXT = 2 };
+
+/* the cache file is read in one go and decoded straight from memory. lengths and
+   numbers are stored in host byte order, the file never leaves this machine */
+class CSkinCacheWriter
+{
+public:
+  void Int(uint32_t value)
+  {
+    m_data.append((const char *)&value, sizeof(value));
+  }
+  void Int64(int64_t value)
+  {
+    m_data.append((const char *)&value, sizeof(value));
+  }
+  void String(const std::string &value)
+  {
+    Int(value.size());
+    m_data.append(value);
+  }
+  void Node(const TiXmlNode *node);
+
+  const std::string &GetData() const { return m_data; }
+
+private:
+  std::string m_data;
+};
+
+class CSkinCacheReader
+{
+public:
+  CSkinCacheReader(const char *data, unsigned int size)
+    : m_pos(data), m_end(data + size), m_ok(true) {}
+
+  uint32_t Int()
+  {
+    uint32_t value = 0;
+    Read(&value, sizeof(value));
+    return value;
+  }
+  int64_t Int64()
+  {
+    int64_t value = 0;
+    Read(&value, sizeof(value));
+    return value;
+  }
+  void String(std::string &value)
+  {
+    uint32_t size = Int();
+    if (!m_ok || size > (uint32_t)(m_end - m_pos))
+    {
+      m_ok = false;
+      value.clear();
+      return;
+    }
+    value.assign(m_pos, size);
+    m_pos += size;
+  }
+  TiXmlNode *Node(int depth);
+
+  bool IsOK() const { return m_ok; }
+
+private:
+  void Read(void *dest, unsigned int size)
+  {
+    if (!m_ok || size > (unsigned int)(m_end - m_pos))
+    {
+      m_ok = false;
+      return;
+    }
+    memcpy(dest, m_pos, size);
+    m_pos += size;
+  }
+
+  const char *m_pos;
+  const char *m_end;
+  bool        m_ok;
+};
+
+void CSkinCacheWriter::Node(const TiXmlNode *node)
+{
+  const TiXmlElement *element = node->ToElement();
+  if (!element)
+  {
+    Int(NODE_TEXT);
+    String(node->ValueStr());
+    return;
+  }
+
+  Int(NODE_ELEMENT);
+  String(element->ValueStr());
+
+  unsigned int count = 0;
+  for (const TiXmlAttribute *attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+    count++;
+  Int(count);
+  for (const TiXmlAttribute *attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+  {
+    String(attribute->NameTStr());
+    String(attribute->ValueStr());
+  }
+
+  // comments and the like are of no use to the window
+  count = 0;
+  for (const TiXmlNode *child = element->FirstChild(); child; child = child->NextSibling())
+    if (child->ToElement() || child->ToText())
+      count++;
+  Int(count);
+  for (const TiXmlNode *child = element->FirstChild(); child; child = child->NextSibling())
+    if (child->ToElement() || child->ToText())
+      Node(child);
+}
+
+TiXmlNode *CSkinCacheReader::Node(int depth)
+{
+  if (depth > SKIN_CACHE_MAX_DEPTH)
+  {
+    m_ok = false;
+    return NULL;
+  }
+
+  uint32_t type = Int();
+  std::string value;
+  String(value);
+  if (!m_ok)
+    return NULL;
+
+  if (type == NODE_TEXT)
+    return new TiXmlText(value.c_str());
+  if (type != NODE_ELEMENT)
+  {
+    m_ok = false;
+    return NULL;
+  }
+
+  TiXmlElement *element = new TiXmlElement(value.c_str());
+  std::string name;
+  uint32_t count = Int();
+  for (uint32_t i = 0; i < count && m_ok; i++)
+  {
+    String(name);
+    String(value);
+    element->SetAttribute(name.c_str(), value.c_str());
+  }
+
+  count = Int();
+  for (uint32_t i = 0; i < count && m_ok; i++)
+  {
+    TiXmlNode *child = Node(depth + 1);
+    if (child)
+      element->LinkEndChild(child);
+  }
+
+  if (!m_ok)
+  {
+    delete element;
+    return NULL;
+  }
+  return element;
+}
+
+CGUISkinDocument::CGUISkinDocument()
+{
+  resolved = false;
+  size = 0;
+}
+
+CStdString CGUISkinCache::GetCacheFile(const CStdString &skinFile)
+{
+  Crc32 crc;
+  crc.ComputeFromLowerCase(skinFile);
+
+  CStdString cacheFile;
+  cacheFile.Format("special://temp/skin-%08x.xsc", (unsigned __int32)crc);
+  return cacheFile;
+}
+
+bool CGUISkinCache::GetFileStamp(const CStdString &file, CGUISkinDocument::STAMP &stamp)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(file, &buffer) != 0)
+    return false;
+  stamp.time = buffer.st_mtime;
+  stamp.size = buffer.st_size;
+  return true;
+}
+
+bool CGUISkinCache::CheckFiles(const CGUISkinDocument::FILES &files)
+{
+  for (CGUISkinDocument::FILES::const_iterator it = files.begin(); it != files.end(); ++it)
+  {
+    CGUISkinDocument::STAMP stamp;
+    if (!GetFileStamp(it->first, stamp) || stamp.time != it->second.time || stamp.size != it->second.size)
+    {
+      CLog::Log(LOGDEBUG, "%s - %s changed", __FUNCTION__, it->first.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CGUISkinCache::AddFile(CGUISkinDocument &skin, const CStdString &file)
+{
+  CGUISkinDocument::STAMP stamp;
+  if (!GetFileStamp(file, stamp))
+    return false;
+  skin.files[file] = stamp;
+  return true;
+}
+
+bool CGUISkinCache::IsValid(const CGUISkinDocument &skin)
+{
+  if (!skin.resolved)
+    return true;
+
+  if (!CheckFiles(skin.files))
+    return false;
+
+  // the conditional includes must still evaluate the same way
+  for (CGUISkinDocument::CONDITIONS::const_iterator it = skin.conditions.begin(); it != skin.conditions.end(); ++it)
+  {
+    if (g_infoManager.GetBool(g_infoManager.TranslateString(it->first)) != it->second)
+      return false;
+  }
+  return true;
+}
+
+bool CGUISkinCache::Parse(const CStdString &skinFile, const CStdString &lowerFile, CGUISkinDocument &skin)
+{
+  skin.resolved = false;
+  skin.size = 0;
+  skin.files.clear();
+  skin.conditions.clear();
+
+  skin.file = skinFile;
+  if (skin.doc.LoadFile(skin.file))
+    return true;
+  skin.file = CStdString(skinFile).ToLower();
+  if (skin.doc.LoadFile(skin.file))
+    return true;
+  skin.file = lowerFile;
+  if (!lowerFile.IsEmpty() && skin.doc.LoadFile(skin.file))
+    return true;
+  skin.file.clear();
+  return false;
+}
+
+bool CGUISkinCache::Read(const CStdString &skinFile, CGUISkinDocument &skin)
+{
+  CFile file;
+  if (!file.Open(GetCacheFile(skinFile)))
+    return false;
+
+  int64_t length = file.GetLength();
+  if (length <= 0 || length > 64 * 1024 * 1024)
+    return false;
+
+  std::vector<char> data((size_t)length);
+  if (file.Read(&data[0], length) != length)
+    return false;
+  file.Close();
+
+  CSkinCacheReader reader(&data[0], data.size());
+
+  std::string value;
+  reader.String(value);
+  if (value != SKIN_CACHE_MAGIC || reader.Int() != SKIN_CACHE_VERSION)
+    return false;
+
+  reader.String(value);
+  if (!reader.IsOK() || CStdString(value) != skinFile)
+    return false; // crc clash
+
+  CGUISkinDocument::FILES files;
+  uint32_t count = reader.Int();
+  for (uint32_t i = 0; i < count && reader.IsOK(); i++)
+  {
+    reader.String(value);
+    CGUISkinDocument::STAMP &stamp = files[value];
+    stamp.time = reader.Int64();
+    stamp.size = reader.Int64();
+  }
+
+  CGUISkinDocument::CONDITIONS conditions;
+  count = reader.Int();
+  for (uint32_t i = 0; i < count && reader.IsOK(); i++)
+  {
+    reader.String(value);
+    conditions[value] = reader.Int() != 0;
+  }
+
+  // the skin files must not have changed
+  if (!reader.IsOK() || !CheckFiles(files))
+    return false;
+
+  TiXmlNode *root = reader.Node(0);
+  if (!root || !reader.IsOK())
+  {
+    CLog::Log(LOGERROR, "%s - invalid cache file for %s", __FUNCTION__, skinFile.c_str());
+    delete root;
+    return false;
+  }
+
+  skin.doc.Clear();
+  skin.doc.LinkEndChild(root);
+  skin.resolved = true;
+  skin.file = skinFile;
+  skin.files.swap(files);
+  skin.conditions.swap(conditions);
+  skin.size = 0;
+  return true;
+}
+
+void CGUISkinCache::Save(const CStdString &skinFile, const CGUISkinDocument &skin)
+{
+  const TiXmlElement *root = skin.doc.RootElement();
+  if (!root || !skin.resolved)
+    return;
+
+  CSkinCacheWriter writer;
+  writer.String(SKIN_CACHE_MAGIC);
+  writer.Int(SKIN_CACHE_VERSION);
+  writer.String(skinFile);
+
+  writer.Int(skin.files.size());
+  for (CGUISkinDocument::FILES::const_iterator it = skin.files.begin(); it != skin.files.end(); ++it)
+  {
+    writer.String(it->first);
+    writer.Int64(it->second.time);
+    writer.Int64(it->second.size);
+  }
+
+  writer.Int(skin.conditions.size());
+  for (CGUISkinDocument::CONDITIONS::const_iterator it = skin.conditions.begin(); it != skin.conditions.end(); ++it)
+  {
+    writer.String(it->first);
+    writer.Int(it->second ? 1 : 0);
+  }
+
+  writer.Node(root);
+
+  CFile file;
+  if (!file.OpenForWrite(GetCacheFile(skinFile), true))
+    return;
+  const std::string &data = writer.GetData();
+  if (file.Write(data.c_str(), data.size()) != (int)data.size())
+  {
+    file.Close();
+    CFile::Delete(GetCacheFile(skinFile));
+  }
+}
+
+unsigned int CGUISkinCache::GetSize(const TiXmlNode *node)
+{
+  unsigned int size = sizeof(TiXmlElement) + node->ValueStr().size();
+  const TiXmlElement *element = node->ToElement();
+  if (element)
+  {
+    for (const TiXmlAttribute *attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+      size += sizeof(TiXmlAttribute) + attribute->NameTStr().size() + attribute->ValueStr().size();
+  }
+  for (const TiXmlNode *child = node->FirstChild(); child; child = child->NextSibling())
+    size += GetSize(child);
+  return size;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "utils/StdString.h"
+#include "tinyXML/tinyxml.h"
+
+#include <map>
+#include <vector>
+
+/*! \brief A window's skin XML held in memory, either as parsed from the skin file or with its includes resolved.
+ */
+class CGUISkinDocument
+{
+public:
+  typedef std::map<CStdString, bool> CONDITIONS;
+  typedef struct
+  {
+    int64_t time;
+    int64_t size;
+  } STAMP;
+  typedef std::map<CStdString, STAMP> FILES;
+
+  CGUISkinDocument();
+
+  TiXmlDocument doc;
+  bool          resolved;   ///< true if includes, defaults and constants have been resolved
+  CStdString    file;       ///< the skin file that was parsed
+  FILES         files;      ///< the skin files the resolved XML was built from
+  CONDITIONS    conditions; ///< the include conditions evaluated while resolving, with their results
+  unsigned int  size;       ///< estimated memory use in bytes, 0 if not yet known
+};
+
+/*! \brief Disk cache of window skin files with their includes, defaults and constants resolved.
+
+ Loading a window from the cache skips parsing the XML text as well as resolving its
+ includes. An entry remembers the files it was built from and the results of any include
+ conditions, and is ignored as soon as one of the files or conditions changed.
+ */
+class CGUISkinCache
+{
+public:
+  /*! \brief Read the resolved XML of a window from the cache.
+   Safe to call from any thread. The conditions are not checked, see IsValid().
+   \param skinFile the window's skin file, as passed to CGUIWindow::LoadXML
+   \param skin [out] the document to fill
+   \return true if an entry with unchanged files was found, false otherwise
+   */
+  static bool Read(const CStdString &skinFile, CGUISkinDocument &skin);
+
+  /*! \brief Parse a window's skin file without resolving it.
+   Safe to call from any thread.
+   \param skinFile the window's skin file
+   \param lowerFile the lower case fallback for the skin file
+   \param skin [out] the document to fill, holds the parser error on failure
+   \return true if one of the files could be parsed, false otherwise
+   */
+  static bool Parse(const CStdString &skinFile, const CStdString &lowerFile, CGUISkinDocument &skin);
+
+  /*! \brief Check whether a resolved document still matches the skin files and include conditions.
+   Must be called from the application thread, as it evaluates the conditions.
+   */
+  static bool IsValid(const CGUISkinDocument &skin);
+
+  /*! \brief Remember the current state of a file the resolved XML depends on
+   \return false if the file can't be stat'ed
+   */
+  static bool AddFile(CGUISkinDocument &skin, const CStdString &file);
+
+  /*! \brief Store the resolved XML of a window.
+   \param skinFile the window's skin file, as passed to CGUIWindow::LoadXML
+   \param skin the resolved document
+   */
+  static void Save(const CStdString &skinFile, const CGUISkinDocument &skin);
+
+  /*! \brief Estimate the memory a document takes up
+   */
+  static unsigned int GetSize(const TiXmlNode *node);
+
+private:
+  static CStdString GetCacheFile(const CStdString &skinFile);
+  static bool GetFileStamp(const CStdString &file, CGUISkinDocument::STAMP &stamp);
+  static bool CheckFiles(const CGUISkinDocument::FILES &files);
+};
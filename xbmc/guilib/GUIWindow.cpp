@@ -26,6 +26,7 @@
 #include "LocalizeStrings.h"
 #include "GUIControlFactory.h"
 #include "GUIControlGroup.h"
+#include "GUISkinCache.h"
 #include "GUIControlProfiler.h"
 #include "settings/Settings.h"
 #ifdef PRE_SKIN_VERSION_9_10_COMPATIBILITY
@@ -109,18 +110,83 @@ bool CGUIWindow::Load(const CStdString& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const CStdString &strPath, const CStdString &strLowerPath)
 {
-  TiXmlDocument xmlDoc;
-  if ( !xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(CStdString(strPath).ToLower()) && !xmlDoc.LoadFile(strLowerPath))
+  int64_t start = CurrentHostCounter();
+
+  // the xml held by the preloader is used if it's still current, then the disk cache, then the skin file
+  const char *source = "preload";
+  CGUISkinDocument *skin = g_windowManager.GetPreloader().Take(strPath);
+  if (skin && !CGUISkinCache::IsValid(*skin))
   {
-    CLog::Log(LOGERROR, "unable to load:%s, Line %d\n%s", strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
-    SetID(WINDOW_INVALID);
-    return false;
+    delete skin;
+    skin = NULL;
+  }
+  if (!skin)
+  {
+    skin = new CGUISkinDocument;
+    source = "cache";
+    if (!CGUISkinCache::Read(strPath, *skin) || !CGUISkinCache::IsValid(*skin))
+    {
+      source = "file";
+      if (!CGUISkinCache::Parse(strPath, strLowerPath, *skin))
+      {
+        CLog::Log(LOGERROR, "unable to load:%s, Line %d\n%s", strPath.c_str(), skin->doc.ErrorRow(), skin->doc.ErrorDesc());
+        delete skin;
+        SetID(WINDOW_INVALID);
+        return false;
+      }
+    }
+  }
+
+  TiXmlElement *pRootElement = skin->doc.RootElement();
+  if (!skin->resolved && pRootElement && strcmpi(pRootElement->Value(), "window") == 0)
+  {
+    // resolve the includes here so the result can be held and cached for the next load
+    g_SkinInfo->ResolveIncludes(pRootElement, &skin->conditions);
+    skin->resolved = true;
+
+    bool stamped = CGUISkinCache::AddFile(*skin, skin->file);
+    const std::vector<CStdString> &includes = g_SkinInfo->GetIncludeFiles();
+    for (unsigned int i = 0; i < includes.size(); i++)
+      stamped &= CGUISkinCache::AddFile(*skin, includes[i]);
+    if (stamped)
+      CGUISkinCache::Save(strPath, *skin);
   }
+  if (!skin->size && pRootElement)
+    skin->size = CGUISkinCache::GetSize(pRootElement);
 
-  return Load(xmlDoc);
+  bool ret = Load(skin->doc, true);
+
+  CGUIControlProfiler::Instance().AddWindowLoad(GetID(), strPath, source, 1000.f * (CurrentHostCounter() - start) / CurrentHostFrequency(), skin->size);
+
+  // windows that are rebuilt on every activation hold on to their xml
+  if (ret && m_loadOnDemand)
+    g_windowManager.GetPreloader().Store(strPath, skin);
+  else
+    delete skin;
+  return ret;
+}
+
+bool CGUIWindow::GetSkinPaths(CStdString &strPath, CStdString &strLowerPath) const
+{
+  CStdString xmlFile = GetProperty("xmlfile");
+  if (xmlFile.IsEmpty() || g_SkinInfo == NULL)
+    return false;
+
+  if (xmlFile.Find("\\") > -1 || xmlFile.Find("/") > -1)
+  {
+    strPath = xmlFile;
+    strLowerPath.clear();
+  }
+  else
+  {
+    RESOLUTION_INFO res;
+    strLowerPath = g_SkinInfo->GetSkinPath(CStdString(xmlFile).ToLower(), &res);
+    strPath = g_SkinInfo->GetSkinPath(xmlFile, &res);
+  }
+  return true;
 }
 
-bool CGUIWindow::Load(TiXmlDocument &xmlDoc)
+bool CGUIWindow::Load(TiXmlDocument &xmlDoc, bool resolved)
 {
   TiXmlElement* pRootElement = xmlDoc.RootElement();
   if (strcmpi(pRootElement->Value(), "window"))
@@ -134,7 +200,8 @@ bool CGUIWindow::Load(TiXmlDocument &xmlDoc)
   g_graphicsContext.SetScalingResolution(m_coordsRes, m_needsScaling);
 
   // Resolve any includes that may be present
-  g_SkinInfo->ResolveIncludes(pRootElement);
+  if (!resolved)
+    g_SkinInfo->ResolveIncludes(pRootElement);
   // now load in the skin file
   SetDefaults();
 
@@ -449,6 +516,7 @@ bool CGUIWindow::OnMessage(CGUIMessage& message)
       CLog::Log(LOGDEBUG, "------ Window Init (%s) ------", GetProperty("xmlfile").c_str());
       if (m_dynamicResourceAlloc || !m_bAllocated) AllocResources();
       OnInitWindow();
+      g_windowManager.OnWindowInit(GetID());
       return true;
     }
     break;
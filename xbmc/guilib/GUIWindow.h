@@ -141,6 +141,13 @@ public:
   const RESOLUTION_INFO &GetCoordsRes() const { return m_coordsRes; };
   void LoadOnDemand(bool loadOnDemand) { m_loadOnDemand = loadOnDemand; };
   bool GetLoadOnDemand() { return m_loadOnDemand; }
+
+  /*! \brief Get the skin file the window is loaded from
+   \param strPath [out] the skin file
+   \param strLowerPath [out] the lower case fallback for the skin file, empty if the window has a full path
+   \return false if the window has no skin file
+   */
+  bool GetSkinPaths(CStdString &strPath, CStdString &strLowerPath) const;
   int GetRenderOrder() { return m_renderOrder; };
   virtual void SetInitialVisibility();
 
@@ -211,7 +218,7 @@ public:
 protected:
   virtual EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event);
   virtual bool LoadXML(const CStdString& strPath, const CStdString &strLowerPath);  ///< Loads from the given file
-  bool Load(TiXmlDocument &xmlDoc);                 ///< Loads from the given XML document
+  bool Load(TiXmlDocument &xmlDoc, bool resolved = false); ///< Loads from the given XML document, resolving its includes unless already done
   virtual void LoadAdditionalTags(TiXmlElement *root) {}; ///< Load additional information from the XML document
 
   virtual void SetDefaults();
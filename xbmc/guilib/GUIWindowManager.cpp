@@ -26,6 +26,7 @@
 #include "GUIPassword.h"
 #include "GUIInfoManager.h"
 #include "threads/SingleLock.h"
+#include "threads/Atomics.h"
 #include "utils/URIUtils.h"
 #include "settings/GUISettings.h"
 #include "settings/Settings.h"
@@ -34,6 +35,9 @@
 #include "GUITexture.h"
 #include "windowing/WindowingFactory.h"
 
+#include <algorithm>
+#include <functional>
+
 using namespace std;
 
 CGUIWindowManager::CGUIWindowManager(void)
@@ -42,6 +46,8 @@ CGUIWindowManager::CGUIWindowManager(void)
   m_bShowOverlay = true;
   m_iNested = 0;
   m_initialized = false;
+  m_lastInitWindow = WINDOW_INVALID;
+  m_threadMessages = NULL;
 }
 
 CGUIWindowManager::~CGUIWindowManager(void)
@@ -495,7 +501,7 @@ bool RenderOrderSortFunction(CGUIWindow *first, CGUIWindow *second)
 void CGUIWindowManager::Process(unsigned int currentTime)
 {
   assert(g_application.IsCurrentThread());
-  CSingleLock lock(g_graphicsContext);
+  CRenderThreadLock lock;
 
   CDirtyRegionList dirtyregions;
 
@@ -543,7 +549,7 @@ void CGUIWindowManager::RenderPass()
 void CGUIWindowManager::Render()
 {
   assert(g_application.IsCurrentThread());
-  CSingleLock lock(g_graphicsContext);
+  CRenderThreadLock lock;
 
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
@@ -579,7 +585,7 @@ void CGUIWindowManager::Render()
 void CGUIWindowManager::FrameMove()
 {
   assert(g_application.IsCurrentThread());
-  CSingleLock lock(g_graphicsContext);
+  CRenderThreadLock lock;
 
   if(m_iNested == 0)
   {
@@ -653,6 +659,8 @@ void CGUIWindowManager::DeInitialize()
     pWindow->FreeResources(true);
   }
   UnloadNotOnDemandWindows();
+  m_preloader.Clear();
+  m_lastInitWindow = WINDOW_INVALID;
 
   m_vecMsgTargets.erase( m_vecMsgTargets.begin(), m_vecMsgTargets.end() );
 
@@ -736,41 +744,47 @@ int CGUIWindowManager::GetTopMostModalDialogID() const
 
 void CGUIWindowManager::SendThreadMessage(CGUIMessage& message)
 {
-  CSingleLock lock(m_critSection);
-
-  CGUIMessage* msg = new CGUIMessage(message);
-  m_vecThreadMessages.push_back( pair<CGUIMessage*,int>(msg,0) );
+  SendThreadMessage(message, 0);
 }
 
 void CGUIWindowManager::SendThreadMessage(CGUIMessage& message, int window)
 {
-  CSingleLock lock(m_critSection);
-
-  CGUIMessage* msg = new CGUIMessage(message);
-  m_vecThreadMessages.push_back( pair<CGUIMessage*,int>(msg,window) );
+  ThreadMessage *entry = new ThreadMessage;
+  entry->message = new CGUIMessage(message);
+  entry->window = window;
+  do
+    entry->next = m_threadMessages;
+  while (cas((volatile long *)&m_threadMessages, (long)entry->next, (long)entry) != (long)entry->next);
 }
 
 void CGUIWindowManager::DispatchThreadMessages()
 {
-  CSingleLock lock(m_critSection);
-  vector< pair<CGUIMessage*,int> > messages(m_vecThreadMessages);
-  m_vecThreadMessages.erase(m_vecThreadMessages.begin(), m_vecThreadMessages.end());
-  lock.Leave();
+  // take all queued messages at once, so any sent while we dispatch wait for the next frame
+  ThreadMessage *entry = m_threadMessages;
+  while (cas((volatile long *)&m_threadMessages, (long)entry, 0) != (long)entry)
+    entry = m_threadMessages;
+
+  // and put them back in the order they were sent
+  ThreadMessage *messages = NULL;
+  while (entry)
+  {
+    ThreadMessage *next = entry->next;
+    entry->next = messages;
+    messages = entry;
+    entry = next;
+  }
 
-  while ( messages.size() > 0 )
+  while (messages)
   {
-    vector< pair<CGUIMessage*,int> >::iterator it = messages.begin();
-    CGUIMessage* pMsg = it->first;
-    int window = it->second;
-    // first remove the message from the queue,
-    // else the message could be processed more then once
-    it = messages.erase(it);
+    entry = messages;
+    messages = messages->next;
 
-    if (window)
-      SendMessage( *pMsg, window );
+    if (entry->window)
+      SendMessage( *entry->message, entry->window );
     else
-      SendMessage( *pMsg );
-    delete pMsg;
+      SendMessage( *entry->message );
+    delete entry->message;
+    delete entry;
   }
 }
 
@@ -837,6 +851,45 @@ bool CGUIWindowManager::IsWindowVisible(const CStdString &xmlFile) const
   return IsWindowActive(xmlFile, false);
 }
 
+void CGUIWindowManager::OnWindowInit(int id)
+{
+  CSingleLock lock(g_graphicsContext);
+  if (m_lastInitWindow != WINDOW_INVALID && m_lastInitWindow != id)
+    m_navigation[m_lastInitWindow][id]++;
+  m_lastInitWindow = id;
+
+  if (g_advancedSettings.m_guiPreloadWindows <= 0)
+    return;
+
+  map<int, WindowCounts>::const_iterator it = m_navigation.find(id);
+  if (it == m_navigation.end())
+    return;
+
+  // pick the windows that followed this one most often, ignoring one-offs
+  vector< pair<unsigned int, int> > next;
+  for (WindowCounts::const_iterator i = it->second.begin(); i != it->second.end(); ++i)
+  {
+    if (i->second > 1)
+      next.push_back(make_pair(i->second, i->first));
+  }
+  sort(next.begin(), next.end(), greater< pair<unsigned int, int> >());
+
+  int preloads = 0;
+  for (unsigned int i = 0; i < next.size() && preloads < g_advancedSettings.m_guiPreloadWindows; i++)
+  {
+    CGUIWindow *window = GetWindow(next[i].second);
+    if (!window || !window->GetLoadOnDemand() || IsWindowActive(next[i].second, false))
+      continue;
+
+    CStdString strPath, strLowerPath;
+    if (window->GetSkinPaths(strPath, strLowerPath))
+    {
+      m_preloader.Preload(strPath, strLowerPath);
+      preloads++;
+    }
+  }
+}
+
 void CGUIWindowManager::LoadNotOnDemandWindows()
 {
   CSingleLock lock(g_graphicsContext);
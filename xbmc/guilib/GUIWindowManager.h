@@ -33,6 +33,7 @@
 #include "IWindowManagerCallback.h"
 #include "IMsgTargetCallback.h"
 #include "DirtyRegionTracker.h"
+#include "GUIWindowPreloader.h"
 
 class CGUIDialog;
 
@@ -124,6 +125,16 @@ public:
   bool IsOverlayAllowed() const;
   void ShowOverlay(CGUIWindow::OVERLAY_STATE state);
   void GetActiveModelessWindows(std::vector<int> &ids);
+
+  /*! \brief Record that a window was shown and preload the windows most often shown after it.
+   Called by the window on GUI_MSG_WINDOW_INIT.
+   \param id the id of the window being shown
+   */
+  void OnWindowInit(int id);
+
+  /*! \brief Holds the skin xml of windows in between loads, see CGUIWindowPreloader
+   */
+  CGUIWindowPreloader &GetPreloader() { return m_preloader; };
 #ifdef _DEBUG
   void DumpTextureUse();
 #endif
@@ -153,8 +164,16 @@ private:
   std::stack<int> m_windowHistory;
 
   IWindowManagerCallback* m_pCallback;
-  std::vector < std::pair<CGUIMessage*,int> > m_vecThreadMessages;
-  CCriticalSection m_critSection;
+
+  // messages from other threads, newest first. Any thread pushes without taking a lock,
+  // and the render thread takes the lot at the start of each frame.
+  struct ThreadMessage
+  {
+    CGUIMessage   *message;
+    int            window;
+    ThreadMessage *next;
+  };
+  ThreadMessage * volatile m_threadMessages;
   std::vector <IMsgTargetCallback*> m_vecMsgTargets;
 
   bool m_bShowOverlay;
@@ -162,6 +181,12 @@ private:
   bool m_initialized;
 
   CDirtyRegionTracker m_tracker;
+
+  // how often each window was followed by another one, for guessing which windows to preload
+  typedef std::map<int, unsigned int> WindowCounts;
+  std::map<int, WindowCounts> m_navigation;
+  int m_lastInitWindow;
+  CGUIWindowPreloader m_preloader;
 };
 
 /*!
@@ -0,0 +1,189 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "GUIWindowPreloader.h"
+#include "GUISkinCache.h"
+#include "settings/AdvancedSettings.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+using namespace std;
+
+class CGUIWindowPreloadJob : public CJob
+{
+public:
+  CGUIWindowPreloadJob(const CStdString &skinFile, const CStdString &lowerFile)
+    : m_skinFile(skinFile), m_lowerFile(lowerFile)
+  {
+    m_skin = new CGUISkinDocument;
+  }
+  virtual ~CGUIWindowPreloadJob()
+  {
+    delete m_skin;
+  }
+
+  virtual const char *GetType() const { return "windowpreload"; };
+
+  virtual bool DoWork()
+  {
+    // the include conditions can only be checked on the app thread when the window is loaded
+    if (!CGUISkinCache::Read(m_skinFile, *m_skin) && !CGUISkinCache::Parse(m_skinFile, m_lowerFile, *m_skin))
+      return false;
+    if (m_skin->doc.RootElement())
+      m_skin->size = CGUISkinCache::GetSize(m_skin->doc.RootElement());
+    return true;
+  }
+
+  CGUISkinDocument *Detach()
+  {
+    CGUISkinDocument *skin = m_skin;
+    m_skin = NULL;
+    return skin;
+  }
+
+  const CStdString &GetSkinFile() const { return m_skinFile; }
+
+private:
+  CStdString        m_skinFile;
+  CStdString        m_lowerFile;
+  CGUISkinDocument *m_skin;
+};
+
+CGUIWindowPreloader::CGUIWindowPreloader()
+  : CJobQueue(false, 1, CJob::PRIORITY_LOW)
+{
+  m_size = 0;
+}
+
+CGUIWindowPreloader::~CGUIWindowPreloader()
+{
+  Clear();
+}
+
+void CGUIWindowPreloader::Preload(const CStdString &skinFile, const CStdString &lowerFile)
+{
+  if (g_advancedSettings.m_guiWindowMemory <= 0)
+    return;
+
+  CSingleLock lock(m_critSection);
+  if (m_pending.find(skinFile) != m_pending.end())
+    return;
+  for (DOCUMENTS::const_iterator it = m_documents.begin(); it != m_documents.end(); ++it)
+  {
+    if (it->first == skinFile)
+      return;
+  }
+
+  CLog::Log(LOGDEBUG, "%s - %s", __FUNCTION__, skinFile.c_str());
+  m_pending.insert(skinFile);
+  lock.Leave();
+  AddJob(new CGUIWindowPreloadJob(skinFile, lowerFile));
+}
+
+CGUISkinDocument *CGUIWindowPreloader::Take(const CStdString &skinFile)
+{
+  CSingleLock lock(m_critSection);
+  for (DOCUMENTS::iterator it = m_documents.begin(); it != m_documents.end(); ++it)
+  {
+    if (it->first == skinFile)
+    {
+      CGUISkinDocument *skin = it->second;
+      m_size -= skin->size;
+      m_documents.erase(it);
+      return skin;
+    }
+  }
+  return NULL;
+}
+
+void CGUIWindowPreloader::Store(const CStdString &skinFile, CGUISkinDocument *skin)
+{
+  if (!skin->size && skin->doc.RootElement())
+    skin->size = CGUISkinCache::GetSize(skin->doc.RootElement());
+
+  CSingleLock lock(m_critSection);
+  Insert(skinFile, skin);
+}
+
+void CGUIWindowPreloader::Insert(const CStdString &skinFile, CGUISkinDocument *skin)
+{
+  // a newer document replaces the one held
+  for (DOCUMENTS::iterator it = m_documents.begin(); it != m_documents.end(); ++it)
+  {
+    if (it->first == skinFile)
+    {
+      m_size -= it->second->size;
+      delete it->second;
+      m_documents.erase(it);
+      break;
+    }
+  }
+
+  m_documents.push_front(make_pair(skinFile, skin));
+  m_size += skin->size;
+
+  // drop the least recently used documents until we're within budget again
+  unsigned int budget = g_advancedSettings.m_guiWindowMemory > 0 ? g_advancedSettings.m_guiWindowMemory * 1024 : 0;
+  while (m_size > budget && !m_documents.empty())
+  {
+    CGUISkinDocument *last = m_documents.back().second;
+    CLog::Log(LOGDEBUG, "%s - dropping %s (%ukB)", __FUNCTION__, m_documents.back().first.c_str(), last->size / 1024);
+    m_size -= last->size;
+    delete last;
+    m_documents.pop_back();
+  }
+}
+
+void CGUIWindowPreloader::Clear()
+{
+  CancelJobs();
+
+  CSingleLock lock(m_critSection);
+  for (DOCUMENTS::iterator it = m_documents.begin(); it != m_documents.end(); ++it)
+    delete it->second;
+  m_documents.clear();
+  m_pending.clear();
+  m_size = 0;
+}
+
+void CGUIWindowPreloader::OnJobComplete(unsigned int jobID, bool success, CJob *job)
+{
+  CGUIWindowPreloadJob *preload = (CGUIWindowPreloadJob *)job;
+  {
+    CSingleLock lock(m_critSection);
+    // jobs cancelled by Clear() are no longer pending
+    if (m_pending.erase(preload->GetSkinFile()) && success)
+    {
+      bool held = false;
+      for (DOCUMENTS::const_iterator it = m_documents.begin(); it != m_documents.end(); ++it)
+      {
+        if (it->first == preload->GetSkinFile())
+        {
+          held = true;
+          break;
+        }
+      }
+      if (!held)
+        Insert(preload->GetSkinFile(), preload->Detach());
+    }
+  }
+  CJobQueue::OnJobComplete(jobID, success, job);
+}
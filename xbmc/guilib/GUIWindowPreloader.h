@@ -0,0 +1,78 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "threads/CriticalSection.h"
+#include "utils/JobManager.h"
+#include "utils/StdString.h"
+
+#include <list>
+#include <set>
+
+class CGUISkinDocument;
+
+/*! \brief Holds the skin XML of windows in memory, ready to be built.
+
+ Documents arrive either from a background job reading a window's skin ahead of its
+ activation, or are handed back after a load on demand window was built from them.
+ The least recently used documents are dropped once the memory budget set by
+ <gui><windowmemory> in advancedsettings.xml is exceeded.
+ */
+class CGUIWindowPreloader : public CJobQueue
+{
+public:
+  CGUIWindowPreloader();
+  virtual ~CGUIWindowPreloader();
+
+  /*! \brief Read a window's skin file on a background job, unless it's held already.
+   \param skinFile the window's skin file
+   \param lowerFile the lower case fallback for the skin file
+   */
+  void Preload(const CStdString &skinFile, const CStdString &lowerFile);
+
+  /*! \brief Take the document held for a window's skin file.
+   \param skinFile the window's skin file
+   \return the document, owned by the caller from now on, or NULL if none is held
+   */
+  CGUISkinDocument *Take(const CStdString &skinFile);
+
+  /*! \brief Hold the document of a window that was built from it.
+   \param skinFile the window's skin file
+   \param skin the document, owned by the preloader from now on
+   */
+  void Store(const CStdString &skinFile, CGUISkinDocument *skin);
+
+  /*! \brief Drop all documents and cancel any pending jobs, eg on skin change.
+   */
+  void Clear();
+
+  virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
+
+private:
+  void Insert(const CStdString &skinFile, CGUISkinDocument *skin);
+
+  typedef std::list< std::pair<CStdString, CGUISkinDocument*> > DOCUMENTS;
+  DOCUMENTS             m_documents; // most recently used first
+  std::set<CStdString>  m_pending;
+  unsigned int          m_size;
+  CCriticalSection      m_critSection;
+};
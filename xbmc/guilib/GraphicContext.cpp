@@ -33,11 +33,15 @@
 #include "GUIWindowManager.h"
 #include "utils/JobManager.h"
 #include "video/VideoReferenceClock.h"
+#include "utils/log.h"
 
 using namespace std;
 
 extern bool g_fullScreen;
 
+#define LOCKWAIT_SPIKE_MS   10.0
+#define LOCKWAIT_SUMMARY_MS 60000
+
 /* quick access to a skin setting, fine unless we starts clearing video settings */
 static CSettingInt* g_guiSkinzoom = NULL;
 
@@ -61,12 +65,44 @@ CGraphicContext::CGraphicContext(void) :
   /*m_finalTransform, */
   /*m_groupTransform*/
 {
+  m_lockWait = 0;
+  m_lockWaitFrames = 0;
+  m_lockWaitSpikes = 0;
+  m_lockWaitTotal = 0.0;
+  m_lockWaitMax = 0.0;
+  m_lockWaitTime = 0;
 }
 
 CGraphicContext::~CGraphicContext(void)
 {
 }
 
+void CGraphicContext::UpdateLockWait()
+{
+  double wait = (double)m_lockWait * 1000.0 / CurrentHostFrequency();
+  m_lockWait = 0;
+
+  m_lockWaitFrames++;
+  m_lockWaitTotal += wait;
+  if (wait > m_lockWaitMax)
+    m_lockWaitMax = wait;
+  if (wait >= LOCKWAIT_SPIKE_MS)
+    m_lockWaitSpikes++;
+
+  unsigned int now = CTimeUtils::GetTimeMS();
+  if (now - m_lockWaitTime >= LOCKWAIT_SUMMARY_MS)
+  {
+    if (m_lockWaitSpikes)
+      CLog::Log(LOGDEBUG, "%s - %u frames waited %.3f ms on average, %.1f ms at most, %u waited over %.0f ms",
+                __FUNCTION__, m_lockWaitFrames, m_lockWaitTotal / m_lockWaitFrames, m_lockWaitMax, m_lockWaitSpikes, LOCKWAIT_SPIKE_MS);
+    m_lockWaitFrames = 0;
+    m_lockWaitSpikes = 0;
+    m_lockWaitTotal = 0.0;
+    m_lockWaitMax = 0.0;
+    m_lockWaitTime = now;
+  }
+}
+
 void CGraphicContext::SetOrigin(float x, float y)
 {
   if (m_origins.size())
@@ -41,6 +41,8 @@
 #include <stack>
 #include <map>
 #include "threads/CriticalSection.h"  // base class
+#include "threads/SingleLock.h"
+#include "utils/TimeUtils.h"
 #include "TransformMatrix.h"        // for the members m_guiTransform etc.
 #include "Geometry.h"               // for CRect/CPoint
 #include "gui3d.h"
@@ -97,6 +99,17 @@ public:
   void ResetScreenParameters(RESOLUTION res);
   void Lock() { EnterCriticalSection(*this); }
   void Unlock() { LeaveCriticalSection(*this); }
+
+  /*! \brief Add time the render thread spent waiting for other threads to release the context
+   \param ticks time waited, in CurrentHostCounter() ticks
+   \sa CRenderThreadLock
+   */
+  void AddLockWait(int64_t ticks) { m_lockWait += ticks; }
+
+  /*! \brief Account the render thread's wait for this frame, called once per frame
+   A summary is logged once a minute if any frame waited noticeably.
+   */
+  void UpdateLockWait();
   float GetPixelRatio(RESOLUTION iRes) const;
   void CaptureStateBlock();
   void ApplyStateBlock();
@@ -225,6 +238,13 @@ private:
   TransformMatrix m_guiTransform;
   TransformMatrix m_finalTransform;
   std::stack<TransformMatrix> m_groupTransform;
+
+  int64_t      m_lockWait;        // render thread wait this frame, in host ticks
+  unsigned int m_lockWaitFrames;
+  unsigned int m_lockWaitSpikes;  // frames that waited LOCKWAIT_SPIKE_MS or more
+  double       m_lockWaitTotal;   // ms
+  double       m_lockWaitMax;     // ms
+  unsigned int m_lockWaitTime;    // time of the last summary
 };
 
 /*!
@@ -234,4 +254,23 @@ private:
 
 XBMC_GLOBAL(CGraphicContext,g_graphicsContext);
 
+/*!
+ \ingroup graphics
+ \brief Scoped lock of the graphics context for the render thread
+
+ Adds the time spent waiting for other threads to hold the context to the frame's lock wait.
+ \sa CGraphicContext::UpdateLockWait
+ */
+class CRenderThreadLock
+{
+public:
+  CRenderThreadLock() : m_start(CurrentHostCounter()), m_lock(g_graphicsContext)
+  {
+    g_graphicsContext.AddLockWait(CurrentHostCounter() - m_start);
+  }
+private:
+  int64_t     m_start;
+  CSingleLock m_lock;
+};
+
 #endif
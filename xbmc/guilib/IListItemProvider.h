@@ -0,0 +1,66 @@
+#pragma once
+
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "boost/shared_ptr.hpp"
+#include <vector>
+
+class CGUIListItem; typedef boost::shared_ptr<CGUIListItem> CGUIListItemPtr;
+
+/*!
+ \ingroup controls
+ \brief Fills in list items on request rather than all up front.
+
+ Containers call FetchItems from the application thread with the items that are
+ on screen or about to scroll on, so it must queue the work rather than block.
+ */
+class IListItemProvider
+{
+public:
+  virtual ~IListItemProvider() {}
+
+  /*! \brief Fill in the given items, replacing any earlier request.
+   \param items the items wanted, most urgent first.
+   \param visible the number of items at the front that are on screen.
+   */
+  virtual void FetchItems(const std::vector<CGUIListItemPtr> &items, unsigned int visible) = 0;
+};
+
+/*!
+ \ingroup controls
+ \brief Points at whichever provider currently fills a list.
+
+ A list and all containers bound to it share the link, so a provider attached
+ after the list has been bound is still found, and one that goes away simply
+ clears it.
+ */
+class CListItemProviderLink
+{
+public:
+  CListItemProviderLink() { m_provider = NULL; };
+  void Set(IListItemProvider *provider) { m_provider = provider; };
+  IListItemProvider *Get() const { return m_provider; };
+private:
+  IListItemProvider *m_provider;
+};
+
+typedef boost::shared_ptr<CListItemProviderLink> CListItemProviderLinkPtr;
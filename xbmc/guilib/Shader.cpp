@@ -27,9 +27,18 @@
 #include "Shader.h"
 #include "utils/log.h"
 #include "utils/GLUtils.h"
+#include "utils/Crc32.h"
+#include <map>
+#include <string.h>
 
 #define LOG_SIZE 1024
 
+#if defined(HAS_GL) && defined(GL_ARB_get_program_binary)
+#define HAS_PROGRAM_BINARY
+// bump when the layout of the cache files changes
+#define PROGRAM_BINARY_MAGIC 0x58504231 // XPB1
+#endif
+
 using namespace Shaders;
 using namespace XFILE;
 using namespace std;
@@ -295,6 +304,7 @@ void CGLSLShaderProgram::Free()
   m_shaderProgram = 0;
   m_ok = false;
   m_lastProgram = 0;
+  m_uniforms.clear();
 }
 
 bool CGLSLShaderProgram::CompileAndLink()
@@ -313,6 +323,17 @@ bool CGLSLShaderProgram::CompileAndLink()
   // free resources
   Free();
 
+  // a driver that kept the linked program from a previous run saves us
+  // compiling and linking the shaders again
+  if (LoadProgramBinary())
+  {
+    m_validated = false;
+    m_ok = true;
+    OnCompiledAndLinked();
+    VerifyGLState();
+    return true;
+  }
+
   // compiled vertex shader
   if (!m_pVP->Compile())
   {
@@ -349,6 +370,11 @@ bool CGLSLShaderProgram::CompileAndLink()
     VerifyGLState();
   }
 
+#ifdef HAS_PROGRAM_BINARY
+  if (GLEW_ARB_get_program_binary)
+    glProgramParameteri(m_shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+
   // link the program
   glLinkProgram(m_shaderProgram);
   glGetProgramiv(m_shaderProgram, GL_LINK_STATUS, params);
@@ -362,6 +388,8 @@ bool CGLSLShaderProgram::CompileAndLink()
   }
   VerifyGLState();
 
+  SaveProgramBinary();
+
   m_validated = false;
   m_ok = true;
   OnCompiledAndLinked();
@@ -374,6 +402,202 @@ bool CGLSLShaderProgram::CompileAndLink()
   return false;
 }
 
+#ifdef HAS_PROGRAM_BINARY
+// linked programs of this run, so reconfiguring the renderer doesn't go back to disk
+static map<string, string> g_programBinaries;
+#endif
+
+string CGLSLShaderProgram::GetProgramBinaryFile() const
+{
+  // the sources already hold the defines the shader was configured with
+  Crc32 vert, frag;
+  vert.Compute(m_pVP->GetSource().c_str(), m_pVP->GetSource().size());
+  frag.Compute(m_pFP->GetSource().c_str(), m_pFP->GetSource().size());
+
+  CStdString file;
+  file.Format("special://temp/shader-%08x%08x.bin", (unsigned int)vert, (unsigned int)frag);
+  return file;
+}
+
+/*
+ cache file layout: magic, length of the driver ident, driver ident, length of
+ the sources, binary format, binary length, binary. The ident and source length
+ guard against a driver update and against a crc collision.
+ */
+bool CGLSLShaderProgram::LoadProgramBinary()
+{
+#ifdef HAS_PROGRAM_BINARY
+  if (!GLEW_ARB_get_program_binary)
+    return false;
+
+  string name = GetProgramBinaryFile();
+  map<string, string>::iterator it = g_programBinaries.find(name);
+  if (it == g_programBinaries.end())
+  {
+    CFile file;
+    if (!file.Open(name))
+      return false;
+
+    string data;
+    int64_t length = file.GetLength();
+    if (length > 0 && length < 16 * 1024 * 1024)
+    {
+      data.resize((size_t)length);
+      if ((int64_t)file.Read(&data[0], length) != length)
+        data.clear();
+    }
+    file.Close();
+    it = g_programBinaries.insert(make_pair(name, data)).first;
+  }
+
+  const string &data = it->second;
+  string ident = (const char*)glGetString(GL_VENDOR);
+  ident += (const char*)glGetString(GL_RENDERER);
+  ident += (const char*)glGetString(GL_VERSION);
+
+  unsigned int header[5];
+  size_t pos = 2 * sizeof(unsigned int);
+  if (data.size() < pos)
+    return false;
+  memcpy(header, data.c_str(), pos);
+  if (header[0] != PROGRAM_BINARY_MAGIC || header[1] != ident.size()
+  ||  data.size() < pos + ident.size() + 3 * sizeof(unsigned int)
+  ||  data.compare(pos, ident.size(), ident) != 0)
+    return false;
+  pos += ident.size();
+  memcpy(header + 2, data.c_str() + pos, 3 * sizeof(unsigned int));
+  pos += 3 * sizeof(unsigned int);
+  if (header[2] != m_pVP->GetSource().size() + m_pFP->GetSource().size()
+  ||  data.size() != pos + header[4])
+    return false;
+
+  if (!(m_shaderProgram = glCreateProgram()))
+    return false;
+
+  glProgramBinary(m_shaderProgram, header[3], data.c_str() + pos, header[4]);
+
+  GLint status = GL_FALSE;
+  glGetProgramiv(m_shaderProgram, GL_LINK_STATUS, &status);
+  if (status != GL_TRUE)
+  {
+    // the driver refused it, drop the stale file and link from source
+    CLog::Log(LOGDEBUG, "GL: Cached shader program %s rejected", name.c_str());
+    glDeleteProgram(m_shaderProgram);
+    m_shaderProgram = 0;
+    g_programBinaries.erase(name);
+    CFile::Delete(name);
+    VerifyGLState();
+    return false;
+  }
+  CLog::Log(LOGDEBUG, "GL: Loaded shader program from %s", name.c_str());
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CGLSLShaderProgram::SaveProgramBinary()
+{
+#ifdef HAS_PROGRAM_BINARY
+  if (!GLEW_ARB_get_program_binary)
+    return;
+
+  GLint length = 0;
+  glGetProgramiv(m_shaderProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0)
+    return;
+
+  string binary;
+  binary.resize(length);
+  GLenum format = 0;
+  glGetProgramBinary(m_shaderProgram, length, &length, &format, &binary[0]);
+  if (length <= 0)
+    return;
+  binary.resize(length);
+
+  string ident = (const char*)glGetString(GL_VENDOR);
+  ident += (const char*)glGetString(GL_RENDERER);
+  ident += (const char*)glGetString(GL_VERSION);
+
+  unsigned int header[5];
+  header[0] = PROGRAM_BINARY_MAGIC;
+  header[1] = ident.size();
+  header[2] = m_pVP->GetSource().size() + m_pFP->GetSource().size();
+  header[3] = format;
+  header[4] = binary.size();
+
+  string data;
+  data.append((const char*)header, 2 * sizeof(unsigned int));
+  data.append(ident);
+  data.append((const char*)(header + 2), 3 * sizeof(unsigned int));
+  data.append(binary);
+
+  string name = GetProgramBinaryFile();
+  g_programBinaries[name] = data;
+
+  CFile file;
+  if (file.OpenForWrite(name, true))
+  {
+    if (file.Write(data.c_str(), data.size()) != (int)data.size())
+    {
+      file.Close();
+      CFile::Delete(name);
+    }
+  }
+#endif
+}
+
+bool CGLSLShaderProgram::UniformChanged(GLint location, const GLfloat *values, int count)
+{
+  if (location < 0)
+    return false;
+
+  for (vector<UniformValue>::iterator it = m_uniforms.begin(); it != m_uniforms.end(); ++it)
+  {
+    if (it->location != location)
+      continue;
+    if (it->count == count && memcmp(it->values, values, count * sizeof(GLfloat)) == 0)
+      return false;
+    it->count = count;
+    memcpy(it->values, values, count * sizeof(GLfloat));
+    return true;
+  }
+
+  UniformValue uniform;
+  uniform.location = location;
+  uniform.count    = count;
+  memcpy(uniform.values, values, count * sizeof(GLfloat));
+  m_uniforms.push_back(uniform);
+  return true;
+}
+
+void CGLSLShaderProgram::SetUniform1i(GLint location, GLint value)
+{
+  // sampler units and flags, exact as a float
+  GLfloat values[1] = { (GLfloat)value };
+  if (UniformChanged(location, values, 1))
+    glUniform1i(location, value);
+}
+
+void CGLSLShaderProgram::SetUniform1f(GLint location, GLfloat value)
+{
+  if (UniformChanged(location, &value, 1))
+    glUniform1f(location, value);
+}
+
+void CGLSLShaderProgram::SetUniform2f(GLint location, GLfloat x, GLfloat y)
+{
+  GLfloat values[2] = { x, y };
+  if (UniformChanged(location, values, 2))
+    glUniform2f(location, x, y);
+}
+
+void CGLSLShaderProgram::SetUniformMatrix4fv(GLint location, const GLfloat *value)
+{
+  if (UniformChanged(location, value, 16))
+    glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
+
 bool CGLSLShaderProgram::Enable()
 {
 #ifdef HAS_GL
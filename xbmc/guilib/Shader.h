@@ -46,6 +46,7 @@ namespace Shaders {
     virtual GLuint Handle() = 0;
     virtual void SetSource(const string& src) { m_source = src; }
     virtual bool LoadSource(const string& filename, const string& prefix = "");
+    const string& GetSource() const { return m_source; }
     bool OK() { return m_compiled; }
 
   protected:
@@ -212,12 +213,34 @@ namespace Shaders {
     // free resources
     virtual void Free();
 
-    // compile and link the shaders
+    // compile and link the shaders, or load the linked program
+    // from the binary cache when the driver supports it
     virtual bool CompileAndLink();
 
   protected:
+    // set a uniform of the enabled program, skipping the GL call when the
+    // program already holds that value
+    void SetUniform1i(GLint location, GLint value);
+    void SetUniform1f(GLint location, GLfloat value);
+    void SetUniform2f(GLint location, GLfloat x, GLfloat y);
+    void SetUniformMatrix4fv(GLint location, const GLfloat *value);
+
     GLint         m_lastProgram;
     bool          m_validated;
+
+  private:
+    bool UniformChanged(GLint location, const GLfloat *values, int count);
+    bool LoadProgramBinary();
+    void SaveProgramBinary();
+    string GetProgramBinaryFile() const;
+
+    struct UniformValue
+    {
+      GLint   location;
+      int     count;
+      GLfloat values[16];
+    };
+    vector<UniformValue> m_uniforms;
   };
 
 
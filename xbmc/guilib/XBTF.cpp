@@ -197,3 +197,15 @@ std::vector<CXBTFFile>& CXBTF::GetFiles()
 {
   return m_files;
 }
+
+uint32_t CXBTF::HashPath(const char* path)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261U;
+  while (*path)
+  {
+    hash ^= (unsigned char)*path++;
+    hash *= 16777619U;
+  }
+  return hash;
+}
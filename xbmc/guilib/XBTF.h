@@ -28,6 +28,13 @@
 #define XBTF_MAGIC "XBTF"
 #define XBTF_VERSION "2"
 
+// optional path index appended after the frame data. The bundle ends with
+// the offset of the index (u64) followed by XBTF_INDEX_MAGIC; the index is
+// a u32 slot count (power of 2) followed by that many {hash, offset} u32
+// pairs, where offset is the position of the file header (0 = empty slot).
+#define XBTF_INDEX_MAGIC "XBTI"
+#define XBTF_INDEX_TRAILER_SIZE 12
+
 #define XB_FMT_DXT_MASK   15
 #define XB_FMT_UNKNOWN     0
 #define XB_FMT_DXT1        1
@@ -93,6 +100,9 @@ public:
   uint64_t GetHeaderSize() const;
   std::vector<CXBTFFile>& GetFiles();
 
+  /*! \brief Hash of a (normalized) path, as used by the bundle index */
+  static uint32_t HashPath(const char* path);
+
 private:
   std::vector<CXBTFFile> m_files;
 };
@@ -20,31 +20,55 @@
  */
 
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+#include <string.h>
 #include "XBTFReader.h"
 #include "utils/EndianSwap.h"
 #include "utils/CharsetConverter.h"
 #ifdef _WIN32
 #include "FileSystem/SpecialProtocol.h"
 #include "PlatformDefs.h" //for PRIdS, PRId64
+#include <io.h>
 #endif
 
-#define READ_STR(str, size, file) \
-  if (!fread(str, size, 1, file)) \
-    return false;
+#define READ_STR(str, size, offset) \
+  if (offset + size > m_size) \
+    return false; \
+  memcpy(str, m_data + offset, size); \
+  offset += size;
 
-#define READ_U32(i, file) \
-  if (!fread(&i, 4, 1, file)) \
+#define READ_U32(i, offset) \
+  if (offset + 4 > m_size) \
     return false; \
-  i = Endian_SwapLE32(i);
+  memcpy(&i, m_data + offset, 4); \
+  i = Endian_SwapLE32(i); \
+  offset += 4;
 
-#define READ_U64(i, file) \
-  if (!fread(&i, 8, 1, file)) \
+#define READ_U64(i, offset) \
+  if (offset + 8 > m_size) \
     return false; \
-  i = Endian_SwapLE64(i);
+  memcpy(&i, m_data + offset, 8); \
+  i = Endian_SwapLE64(i); \
+  offset += 8;
 
 CXBTFReader::CXBTFReader()
 {
   m_file = NULL;
+  m_headersRead = false;
+  m_data = NULL;
+  m_size = 0;
+#ifdef _WIN32
+  m_mapping = NULL;
+#endif
+  m_index = NULL;
+  m_indexSlots = 0;
+}
+
+CXBTFReader::~CXBTFReader()
+{
+  Close();
 }
 
 bool CXBTFReader::IsOpen() const
@@ -54,6 +78,7 @@ bool CXBTFReader::IsOpen() const
 
 bool CXBTFReader::Open(const CStdString& fileName)
 {
+  Close();
   m_fileName = fileName;
 
 #ifdef _WIN32
@@ -68,69 +93,177 @@ bool CXBTFReader::Open(const CStdString& fileName)
     return false;
   }
 
+  if (!Map())
+  {
+    Close();
+    return false;
+  }
+
+  uint64_t offset = 0;
   char magic[4];
-  READ_STR(magic, 4, m_file);
+  READ_STR(magic, 4, offset);
 
   if (strncmp(magic, XBTF_MAGIC, sizeof(magic)) != 0)
   {
+    Close();
     return false;
   }
 
   char version[1];
-  READ_STR(version, 1, m_file);
+  READ_STR(version, 1, offset);
 
   if (strncmp(version, XBTF_VERSION, sizeof(version)) != 0)
   {
+    Close();
+    return false;
+  }
+
+  // with an index the headers are parsed on demand
+  if (ReadIndex())
+    return true;
+
+  if (!ReadHeaders())
+  {
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+bool CXBTFReader::Map()
+{
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1 || fileStat.st_size == 0)
+  {
+    return false;
+  }
+  m_size = fileStat.st_size;
+
+#ifdef _WIN32
+  m_mapping = CreateFileMapping((HANDLE)_get_osfhandle(_fileno(m_file)), NULL, PAGE_READONLY, 0, 0, NULL);
+  if (m_mapping == NULL)
+  {
+    return false;
+  }
+  m_data = (const unsigned char*)MapViewOfFile((HANDLE)m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+  void* data = mmap(NULL, (size_t)m_size, PROT_READ, MAP_SHARED, fileno(m_file), 0);
+  m_data = data == MAP_FAILED ? NULL : (const unsigned char*)data;
+#endif
+
+  return m_data != NULL;
+}
+
+void CXBTFReader::Unmap()
+{
+#ifdef _WIN32
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping)
+    CloseHandle((HANDLE)m_mapping);
+  m_mapping = NULL;
+#else
+  if (m_data)
+    munmap((void*)m_data, (size_t)m_size);
+#endif
+  m_data = NULL;
+  m_size = 0;
+}
+
+bool CXBTFReader::ReadIndex()
+{
+  if (m_size < XBTF_INDEX_TRAILER_SIZE)
+    return false;
+
+  uint64_t offset = m_size - XBTF_INDEX_TRAILER_SIZE;
+  uint64_t indexOffset;
+  READ_U64(indexOffset, offset);
+
+  char magic[4];
+  READ_STR(magic, 4, offset);
+  if (strncmp(magic, XBTF_INDEX_MAGIC, sizeof(magic)) != 0)
+    return false;
+
+  offset = indexOffset;
+  uint32_t slots;
+  READ_U32(slots, offset);
+
+  // slot count must be a power of 2 and the table has to fit before the trailer
+  if (slots == 0 || (slots & (slots - 1)) != 0 ||
+      offset + (uint64_t)slots * 8 > m_size - XBTF_INDEX_TRAILER_SIZE)
+  {
+    printf("Invalid texture bundle index in %s, ignoring it\n", m_fileName.c_str());
     return false;
   }
 
+  m_index = m_data + offset;
+  m_indexSlots = slots;
+
+  return true;
+}
+
+bool CXBTFReader::ReadFile(uint64_t& offset, CXBTFFile& file) const
+{
+  unsigned int u32;
+  uint64_t u64;
+
+  READ_STR(file.GetPath(), 256, offset);
+  file.GetPath()[255] = '\0';
+  READ_U32(u32, offset);
+  file.SetLoop(u32);
+
+  unsigned int nofFrames;
+  READ_U32(nofFrames, offset);
+
+  for (unsigned int j = 0; j < nofFrames; j++)
+  {
+    CXBTFFrame frame;
+
+    READ_U32(u32, offset);
+    frame.SetWidth(u32);
+    READ_U32(u32, offset);
+    frame.SetHeight(u32);
+    READ_U32(u32, offset);
+    frame.SetFormat(u32);
+    READ_U64(u64, offset);
+    frame.SetPackedSize(u64);
+    READ_U64(u64, offset);
+    frame.SetUnpackedSize(u64);
+    READ_U32(u32, offset);
+    frame.SetDuration(u32);
+    READ_U64(u64, offset);
+    frame.SetOffset(u64);
+
+    file.GetFrames().push_back(frame);
+  }
+
+  return true;
+}
+
+bool CXBTFReader::ReadHeaders()
+{
+  m_headersRead = true;
+
+  uint64_t offset = 4 /* Magic */ + 1 /* Version */;
   unsigned int nofFiles;
-  READ_U32(nofFiles, m_file);
+  READ_U32(nofFiles, offset);
   for (unsigned int i = 0; i < nofFiles; i++)
   {
     CXBTFFile file;
-    unsigned int u32;
-    uint64_t u64;
-
-    READ_STR(file.GetPath(), 256, m_file);
-    READ_U32(u32, m_file);
-    file.SetLoop(u32);
-
-    unsigned int nofFrames;
-    READ_U32(nofFrames, m_file);
-
-    for (unsigned int j = 0; j < nofFrames; j++)
-    {
-      CXBTFFrame frame;
-
-      READ_U32(u32, m_file);
-      frame.SetWidth(u32);
-      READ_U32(u32, m_file);
-      frame.SetHeight(u32);
-      READ_U32(u32, m_file);
-      frame.SetFormat(u32);
-      READ_U64(u64, m_file);
-      frame.SetPackedSize(u64);
-      READ_U64(u64, m_file);
-      frame.SetUnpackedSize(u64);
-      READ_U32(u32, m_file);
-      frame.SetDuration(u32);
-      READ_U64(u64, m_file);
-      frame.SetOffset(u64);
-
-      file.GetFrames().push_back(frame);
-    }
+    if (!ReadFile(offset, file))
+      return false;
 
     m_xbtf.GetFiles().push_back(file);
 
-    m_filesMap[file.GetPath()] = file;
+    if (!m_index)
+      m_filesMap[file.GetPath()] = file;
   }
 
   // Sanity check
-  int64_t pos = ftell(m_file);
-  if (pos != (int64_t)m_xbtf.GetHeaderSize())
+  if (offset != m_xbtf.GetHeaderSize())
   {
-    printf("Expected header size (%"PRId64") != actual size (%"PRId64")\n", m_xbtf.GetHeaderSize(), pos);
+    printf("Expected header size (%"PRIu64") != actual size (%"PRIu64")\n", m_xbtf.GetHeaderSize(), offset);
     return false;
   }
 
@@ -139,6 +272,8 @@ bool CXBTFReader::Open(const CStdString& fileName)
 
 void CXBTFReader::Close()
 {
+  Unmap();
+
   if (m_file)
   {
     fclose(m_file);
@@ -147,6 +282,9 @@ void CXBTFReader::Close()
 
   m_xbtf.GetFiles().clear();
   m_filesMap.clear();
+  m_headersRead = false;
+  m_index = NULL;
+  m_indexSlots = 0;
 }
 
 time_t CXBTFReader::GetLastModificationTimestamp()
@@ -173,38 +311,75 @@ bool CXBTFReader::Exists(const CStdString& name)
 CXBTFFile* CXBTFReader::Find(const CStdString& name)
 {
   std::map<CStdString, CXBTFFile>::iterator iter = m_filesMap.find(name);
-  if (iter == m_filesMap.end())
+  if (iter != m_filesMap.end())
+  {
+    return &(iter->second);
+  }
+
+  if (!m_index)
   {
     return NULL;
   }
 
-  return &(iter->second);
+  // linear probing in the on-disk table, empty slots have a zero offset
+  uint32_t hash = CXBTF::HashPath(name.c_str());
+  for (uint32_t probe = 0; probe < m_indexSlots; probe++)
+  {
+    const unsigned char* slot = m_index + ((hash + probe) & (m_indexSlots - 1)) * 8;
+    uint32_t slotHash, slotOffset;
+    memcpy(&slotHash, slot, 4);
+    memcpy(&slotOffset, slot + 4, 4);
+    slotHash = Endian_SwapLE32(slotHash);
+    slotOffset = Endian_SwapLE32(slotOffset);
+
+    if (slotOffset == 0)
+      break;
+
+    if (slotHash != hash || slotOffset + 256 > m_size ||
+        strncmp((const char*)m_data + slotOffset, name.c_str(), 256) != 0)
+      continue;
+
+    CXBTFFile file;
+    uint64_t offset = slotOffset;
+    if (!ReadFile(offset, file))
+      return NULL;
+
+    CXBTFFile& result = m_filesMap[name];
+    result = file;
+    return &result;
+  }
+
+  return NULL;
 }
 
-bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer)
+const unsigned char* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
 {
-  if (!m_file)
-  {
-    return false;
-  }
-#if defined(__APPLE__) || defined(__FreeBSD__)
-    if (fseeko(m_file, (off_t)frame.GetOffset(), SEEK_SET) == -1)
-#else
-    if (fseeko64(m_file, (off_t)frame.GetOffset(), SEEK_SET) == -1)
-#endif
+  if (!m_data || frame.GetOffset() > m_size || frame.GetPackedSize() > m_size - frame.GetOffset())
   {
-    return false;
+    return NULL;
   }
 
-  if (fread(buffer, 1, (size_t)frame.GetPackedSize(), m_file) != frame.GetPackedSize())
+  return m_data + frame.GetOffset();
+}
+
+bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer)
+{
+  const unsigned char* data = GetFrameData(frame);
+  if (!data)
   {
     return false;
   }
 
+  memcpy(buffer, data, (size_t)frame.GetPackedSize());
+
   return true;
 }
 
 std::vector<CXBTFFile>& CXBTFReader::GetFiles()
 {
+  // the full file list is only needed for directory style queries
+  if (m_data && !m_headersRead)
+    ReadHeaders();
+
   return m_xbtf.GetFiles();
 }
@@ -27,10 +27,20 @@
 #include "utils/StdString.h"
 #include "XBTF.h"
 
+/*!
+ \ingroup textures
+ \brief Reader for XBT texture bundles
+
+ The bundle is mapped into memory once on Open(). If it carries a path index
+ (see XBTF_INDEX_MAGIC) file headers are only parsed when they are looked up,
+ otherwise all headers are parsed up front. Frame data can be accessed in
+ place via GetFrameData() without copying it out of the mapping.
+ */
 class CXBTFReader
 {
 public:
   CXBTFReader();
+  ~CXBTFReader();
   bool IsOpen() const;
   bool Open(const CStdString& fileName);
   void Close();
@@ -38,13 +48,34 @@ public:
   bool Exists(const CStdString& name);
   CXBTFFile* Find(const CStdString& name);
   bool Load(const CXBTFFrame& frame, unsigned char* buffer);
+
+  /*! \brief Get a pointer to the (packed) data of a frame within the mapped bundle
+   \return pointer to GetPackedSize() bytes, valid until Close(), or NULL if the frame is out of bounds
+   */
+  const unsigned char* GetFrameData(const CXBTFFrame& frame) const;
   std::vector<CXBTFFile>&  GetFiles();
 
 private:
+  bool Map();
+  void Unmap();
+  bool ReadFile(uint64_t& offset, CXBTFFile& file) const;
+  bool ReadHeaders();
+  bool ReadIndex();
+
   CXBTF      m_xbtf;
   CStdString m_fileName;
   FILE*      m_file;
   std::map<CStdString, CXBTFFile> m_filesMap;
+  bool       m_headersRead;
+
+  const unsigned char* m_data;
+  uint64_t             m_size;
+#ifdef _WIN32
+  void*                m_mapping; ///< HANDLE of the file mapping
+#endif
+
+  const unsigned char* m_index;
+  uint32_t             m_indexSlots;
 };
 
 #endif
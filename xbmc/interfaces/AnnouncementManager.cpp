@@ -28,16 +28,29 @@
 #include "music/tags/MusicInfoTag.h"
 #include "video/VideoDatabase.h"
 
+#define MAX_PENDING_ANNOUNCEMENTS 256
+
 using namespace std;
 using namespace ANNOUNCEMENT;
 
 CCriticalSection CAnnouncementManager::m_critSection;
 vector<IAnnouncer *> CAnnouncementManager::m_announcers;
+CAnnouncementDispatcher *CAnnouncementManager::m_dispatcher = NULL;
 
-void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
+void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener, bool asynchronous /* = false */)
 {
   CSingleLock lock (m_critSection);
-  m_announcers.push_back(listener);
+  if (asynchronous)
+  {
+    if (m_dispatcher == NULL)
+    {
+      m_dispatcher = new CAnnouncementDispatcher();
+      m_dispatcher->Create();
+    }
+    m_dispatcher->AddAnnouncer(listener);
+  }
+  else
+    m_announcers.push_back(listener);
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -51,6 +64,29 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
       return;
     }
   }
+
+  if (m_dispatcher)
+    m_dispatcher->RemoveAnnouncer(listener);
+}
+
+void CAnnouncementManager::Deinitialize()
+{
+  CAnnouncementDispatcher *dispatcher = NULL;
+  {
+    CSingleLock lock (m_critSection);
+    dispatcher = m_dispatcher;
+    m_dispatcher = NULL;
+  }
+
+  if (dispatcher)
+  {
+    unsigned int dispatched, coalesced, dropped;
+    dispatcher->GetStatistics(dispatched, coalesced, dropped);
+    CLog::Log(LOGDEBUG, "CAnnouncementManager - %u asynchronous announcements dispatched, %u coalesced, %u dropped", dispatched, coalesced, dropped);
+
+    dispatcher->StopThread();
+    delete dispatcher;
+  }
 }
 
 void CAnnouncementManager::Announce(EAnnouncementFlag flag, const char *sender, const char *message)
@@ -63,6 +99,9 @@ void CAnnouncementManager::Announce(EAnnouncementFlag flag, const char *sender,
 {
   CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcement: %s from %s", message, sender);
   CSingleLock lock (m_critSection);
+  if (m_dispatcher)
+    m_dispatcher->Queue(flag, sender, message, data);
+
   for (unsigned int i = 0; i < m_announcers.size(); i++)
     m_announcers[i]->Announce(flag, sender, message, data);
 }
@@ -104,3 +143,124 @@ void CAnnouncementManager::Announce(EAnnouncementFlag flag, const char *sender,
 
   Announce(flag, sender, message, object);
 }
+
+CAnnouncementDispatcher::CAnnouncementDispatcher()
+{
+  m_next = 0;
+  m_dispatched = 0;
+  m_coalesced = 0;
+  m_dropped = 0;
+}
+
+void CAnnouncementDispatcher::AddAnnouncer(IAnnouncer *listener)
+{
+  CSingleLock lock (m_critSection);
+  AnnouncerQueue queue;
+  queue.announcer = listener;
+  m_queues.push_back(queue);
+}
+
+void CAnnouncementDispatcher::RemoveAnnouncer(IAnnouncer *listener)
+{
+  // wait for a running delivery so the announcer can safely be destroyed
+  CSingleLock dispatchLock (m_dispatchSection);
+  CSingleLock lock (m_critSection);
+  for (unsigned int i = 0; i < m_queues.size(); i++)
+  {
+    if (m_queues[i].announcer == listener)
+    {
+      m_dropped += m_queues[i].pending.size();
+      m_queues.erase(m_queues.begin() + i);
+      return;
+    }
+  }
+}
+
+void CAnnouncementDispatcher::Queue(EAnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+{
+  CSingleLock lock (m_critSection);
+  if (m_queues.empty())
+    return;
+
+  AnnouncementPtr announcement(new Announcement());
+  announcement->flag = flag;
+  announcement->sender = sender;
+  announcement->message = message;
+  announcement->data = data;
+
+  for (unsigned int i = 0; i < m_queues.size(); i++)
+  {
+    deque<AnnouncementPtr> &pending = m_queues[i].pending;
+
+    /* only a repeat of the newest pending announcement is dropped, merging with
+       an older one would reorder it against the announcements queued since */
+    if (!pending.empty())
+    {
+      const AnnouncementPtr &last = pending.back();
+      if (last->flag == flag && last->message == announcement->message &&
+          last->sender == announcement->sender && last->data == data)
+      {
+        m_coalesced++;
+        continue;
+      }
+    }
+
+    if (pending.size() >= MAX_PENDING_ANNOUNCEMENTS)
+    {
+      pending.pop_front();
+      m_dropped++;
+    }
+    pending.push_back(announcement);
+  }
+
+  m_pendingEvent.Set();
+}
+
+void CAnnouncementDispatcher::GetStatistics(unsigned int &dispatched, unsigned int &coalesced, unsigned int &dropped)
+{
+  CSingleLock lock (m_critSection);
+  dispatched = m_dispatched;
+  coalesced = m_coalesced;
+  dropped = m_dropped;
+}
+
+void CAnnouncementDispatcher::Process()
+{
+  SetName("CAnnouncementDispatcher");
+
+  while (!m_bStop)
+  {
+    if (!DispatchNext())
+      m_pendingEvent.WaitMSec(500);
+  }
+}
+
+bool CAnnouncementDispatcher::DispatchNext()
+{
+  CSingleLock dispatchLock (m_dispatchSection);
+
+  IAnnouncer *announcer = NULL;
+  AnnouncementPtr announcement;
+  {
+    CSingleLock lock (m_critSection);
+    // serve the announcers round robin so one busy announcer can't starve the others
+    for (unsigned int i = 0; i < m_queues.size() && announcer == NULL; i++)
+    {
+      AnnouncerQueue &queue = m_queues[(m_next + i) % m_queues.size()];
+      if (!queue.pending.empty())
+      {
+        announcer = queue.announcer;
+        announcement = queue.pending.front();
+        queue.pending.pop_front();
+        m_next = (m_next + i + 1) % m_queues.size();
+        m_dispatched++;
+      }
+    }
+  }
+
+  if (announcer == NULL)
+    return false;
+
+  announcer->Announce(announcement->flag, announcement->sender.c_str(), announcement->message.c_str(), announcement->data);
+  return true;
+}
@@ -23,21 +23,88 @@
 #include "IAnnouncer.h"
 #include "FileItem.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/Variant.h"
+#include <deque>
+#include <string>
 #include <vector>
 
 namespace ANNOUNCEMENT
 {
+  /*!
+   \brief Delivers announcements to asynchronous announcers on its own thread
+
+   Every announcer has its own bounded queue so a slow announcer (e.g. a
+   remote client on a bad connection) neither delays the thread raising
+   the announcement nor the other announcers. If a queue is full the oldest
+   pending announcement is dropped, and an announcement identical to the
+   last one still pending is coalesced into it.
+   */
+  class CAnnouncementDispatcher : public CThread
+  {
+  public:
+    CAnnouncementDispatcher();
+
+    void AddAnnouncer(IAnnouncer *listener);
+    void RemoveAnnouncer(IAnnouncer *listener);
+    void Queue(EAnnouncementFlag flag, const char *sender, const char *message, const CVariant &data);
+
+    void GetStatistics(unsigned int &dispatched, unsigned int &coalesced, unsigned int &dropped);
+
+  protected:
+    virtual void Process();
+
+  private:
+    typedef struct
+    {
+      EAnnouncementFlag flag;
+      std::string sender;
+      std::string message;
+      CVariant data;
+    } Announcement;
+    typedef boost::shared_ptr<Announcement> AnnouncementPtr;
+
+    typedef struct
+    {
+      IAnnouncer *announcer;
+      std::deque<AnnouncementPtr> pending;
+    } AnnouncerQueue;
+
+    bool DispatchNext();
+
+    std::vector<AnnouncerQueue> m_queues;
+    unsigned int m_next;
+    unsigned int m_dispatched;
+    unsigned int m_coalesced;
+    unsigned int m_dropped;
+    CCriticalSection m_critSection;
+    CCriticalSection m_dispatchSection;
+    CEvent m_pendingEvent;
+  };
+
   class CAnnouncementManager
   {
   public:
-    static void AddAnnouncer(IAnnouncer *listener);
+    /*!
+     \brief Registers an announcer
+     \param listener Announcer to register
+     \param asynchronous Whether announcements are delivered on the dispatch thread instead of the announcing thread
+     */
+    static void AddAnnouncer(IAnnouncer *listener, bool asynchronous = false);
     static void RemoveAnnouncer(IAnnouncer *listener);
     static void Announce(EAnnouncementFlag flag, const char *sender, const char *message);
     static void Announce(EAnnouncementFlag flag, const char *sender, const char *message, CVariant &data);
     static void Announce(EAnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item);
     static void Announce(EAnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, CVariant &data);
+
+    /*!
+     \brief Stops the dispatch thread of asynchronous announcers
+     */
+    static void Deinitialize();
   private:
     static std::vector<IAnnouncer *> m_announcers;
+    static CAnnouncementDispatcher *m_dispatcher;
     static CCriticalSection m_critSection;
   };
 }
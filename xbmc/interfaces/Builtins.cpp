@@ -21,6 +21,8 @@
 
 #include "system.h"
 #include "utils/AlarmClock.h"
+#include "utils/ArtworkCacheJob.h"
+#include "utils/JobManager.h"
 #include "Application.h"
 #include "Autorun.h"
 #include "Builtins.h"
@@ -35,6 +37,7 @@
 #include "video/dialogs/GUIDialogVideoScan.h"
 #include "dialogs/GUIDialogYesNo.h"
 #include "GUIUserMessages.h"
+#include "TextureCache.h"
 #include "windows/GUIWindowLoginScreen.h"
 #include "video/windows/GUIWindowVideoBase.h"
 #include "addons/GUIWindowAddonBrowser.h"
@@ -48,6 +51,7 @@
 #include "storage/MediaManager.h"
 #include "utils/RssReader.h"
 #include "PartyModeManager.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -163,6 +167,8 @@ const BUILT_IN commands[] = {
   { "UpdateLibrary",              true,   "Update the selected library (music or video)" },
   { "CleanLibrary",               true,   "Clean the video/music library" },
   { "ExportLibrary",              true,   "Export the video/music library" },
+  { "CacheArtwork",               true,   "Download and cache the thumbs and fanart of the video/music library" },
+  { "CompressThumbnails",         true,   "Create DDS versions of all cached thumbs and fanart" },
   { "PageDown",                   true,   "Send a page down event to the pagecontrol with given id" },
   { "PageUp",                     true,   "Send a page up event to the pagecontrol with given id" },
   { "LastFM.Love",                false,  "Add the current playing last.fm radio track to the last.fm loved tracks" },
@@ -1207,6 +1213,21 @@ int CBuiltins::Execute(const CStdString& execString)
       }
     }
   }
+  else if (execute.Equals("cacheartwork"))
+  {
+    int flags = ArtworkVideo | ArtworkMusic;
+    if (params.size() && params[0].Equals("video"))
+      flags = ArtworkVideo;
+    else if (params.size() && params[0].Equals("music"))
+      flags = ArtworkMusic;
+
+    CJobManager::GetInstance().AddJob(new CArtworkCacheJob(flags, g_advancedSettings.m_artworkCacheThreads,
+                                                           g_advancedSettings.m_artworkCacheMaxBandwidth), NULL);
+  }
+  else if (execute.Equals("compressthumbnails"))
+  {
+    CTextureCache::Get().CompressCachedImages(params.size() ? params[0] : "");
+  }
   else if (execute.Equals("exportlibrary"))
   {
     int iHeading = 647;
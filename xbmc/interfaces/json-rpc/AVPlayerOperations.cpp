@@ -172,6 +172,32 @@ JSON_STATUS CAVPlayerOperations::SeekPercentage(const CStdString &method, ITrans
   return ACK;
 }
 
+JSON_STATUS CAVPlayerOperations::GetTelemetry(const CStdString &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
+{
+  if (!IsCorrectPlayer(method) || !g_application.m_pPlayer)
+    return FailedToExecute;
+
+  int count = (int)parameterObject["count"].asInteger();
+  if (!g_application.m_pPlayer->GetTelemetry(result, count > 0 ? count : 0))
+    return FailedToExecute;
+
+  return OK;
+}
+
+JSON_STATUS CAVPlayerOperations::DumpTelemetry(const CStdString &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result)
+{
+  if (!IsCorrectPlayer(method) || !g_application.m_pPlayer)
+    return FailedToExecute;
+
+  CStdString path;
+  if (!g_application.m_pPlayer->DumpTelemetry(path))
+    return FailedToExecute;
+
+  CVariant val = path;
+  result.swap(val);
+  return OK;
+}
+
 bool CAVPlayerOperations::IsCorrectPlayer(const CStdString &method)
 {
   return (method.Left(5).Equals("audio") && g_application.IsPlayingAudio()) || (method.Left(5).Equals("video") && g_application.IsPlayingVideo());
@@ -185,9 +185,9 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   if (resultname)
   {
     if (append)
-      result[resultname].append(object);
+      result[resultname].swap_back(object);
     else
-      result[resultname] = object;
+      result[resultname].swap(object);
   }
 }
 
@@ -138,7 +138,25 @@ JSON_STATUS CJSONRPC::NotifyAll(const CStdString &method, ITransportLayer *trans
 
 CStdString CJSONRPC::MethodCall(const CStdString &inputString, ITransportLayer *transport, IClient *client)
 {
-  CVariant inputroot, outputroot, result;
+  CVariant outputroot;
+  bool hasResponse = HandleCall(inputString, transport, client, outputroot);
+
+  CStdString str = hasResponse ? CJSONVariantWriter::Write(outputroot, g_advancedSettings.m_jsonOutputCompact) : "";
+  return str;
+}
+
+bool CJSONRPC::MethodCall(const CStdString &inputString, ITransportLayer *transport, IClient *client, IJSONWriteCallback *output)
+{
+  CVariant outputroot;
+  if (!HandleCall(inputString, transport, client, outputroot))
+    return false;
+
+  return CJSONVariantWriter::Write(outputroot, output, g_advancedSettings.m_jsonOutputCompact);
+}
+
+bool CJSONRPC::HandleCall(const CStdString &inputString, ITransportLayer *transport, IClient *client, CVariant &outputroot)
+{
+  CVariant inputroot;
   bool hasResponse = false;
 
   inputroot = CJSONVariantParser::Parse((unsigned char *)inputString.c_str(), inputString.length());
@@ -175,8 +193,7 @@ CStdString CJSONRPC::MethodCall(const CStdString &inputString, ITransportLayer *
     hasResponse = true;
   }
 
-  CStdString str = hasResponse ? CJSONVariantWriter::Write(outputroot, g_advancedSettings.m_jsonOutputCompact) : "";
-  return str;
+  return hasResponse;
 }
 
 bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client)
@@ -30,6 +30,8 @@
 #include "JSONUtils.h"
 #include "JSONServiceDescription.h"
 
+class IJSONWriteCallback;
+
 namespace JSONRPC
 {
   /*!
@@ -63,6 +65,19 @@ namespace JSONRPC
      */
     static CStdString MethodCall(const CStdString &inputString, ITransportLayer *transport, IClient *client);
 
+    /*
+     \brief Handles an incoming JSON RPC request and streams the response
+     \param inputString received JSON RPC request
+     \param transport Transport protocol on which the request arrived
+     \param client Client which sent the request
+     \param output Receiver of the serialized JSON RPC response
+     \return True if a response has been written to output
+
+     Same as MethodCall() but the response is serialized in chunks directly
+     into the given output instead of being built as one string.
+     */
+    static bool MethodCall(const CStdString &inputString, ITransportLayer *transport, IClient *client, IJSONWriteCallback *output);
+
     static JSON_STATUS Introspect(const CStdString &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSON_STATUS Version(const CStdString &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
     static JSON_STATUS Permission(const CStdString &method, ITransportLayer *transport, IClient *client, const CVariant& parameterObject, CVariant &result);
@@ -73,6 +88,7 @@ namespace JSONRPC
   
   private:
     static void setup();
+    static bool HandleCall(const CStdString &inputString, ITransportLayer *transport, IClient *client, CVariant &outputroot);
     static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
@@ -110,6 +110,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "AudioPlayer.SeekTime",                         CAVPlayerOperations::SeekTime },
   { "AudioPlayer.SeekPercentage",                   CAVPlayerOperations::SeekPercentage },
 
+  { "AudioPlayer.GetTelemetry",                     CAVPlayerOperations::GetTelemetry },
+  { "AudioPlayer.DumpTelemetry",                    CAVPlayerOperations::DumpTelemetry },
+
 // Video player
   { "VideoPlayer.State",                            CAVPlayerOperations::State },
   { "VideoPlayer.PlayPause",                        CAVPlayerOperations::PlayPause },
@@ -130,6 +133,9 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "VideoPlayer.SeekTime",                         CAVPlayerOperations::SeekTime },
   { "VideoPlayer.SeekPercentage",                   CAVPlayerOperations::SeekPercentage },
 
+  { "VideoPlayer.GetTelemetry",                     CAVPlayerOperations::GetTelemetry },
+  { "VideoPlayer.DumpTelemetry",                    CAVPlayerOperations::DumpTelemetry },
+
 // Picture player
   { "PicturePlayer.PlayPause",                      CPicturePlayerOperations::PlayPause },
   { "PicturePlayer.Stop",                           CPicturePlayerOperations::Stop },
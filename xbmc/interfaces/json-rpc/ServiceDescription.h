@@ -80,6 +80,26 @@ namespace JSONRPC
       "\"minimum\": 0.0,"
       "\"maximum\": 100.0"
     "}",
+    "\"Player.Telemetry.Record\": {"
+      "\"type\": \"object\","
+      "\"properties\": {"
+        "\"time\": { \"type\": \"number\", \"required\": true, \"description\": \"Absolute clock in seconds when the record was taken\" },"
+        "\"clock\": { \"type\": \"number\", \"required\": true, \"description\": \"Player clock in seconds\" },"
+        "\"pts\": { \"type\": \"number\", \"description\": \"Timestamp of the frame or packet in seconds\" },"
+        "\"render\": { \"type\": \"number\", \"required\": true, \"description\": \"Milliseconds until the frame is shown or the packet is heard\" },"
+        "\"error\": { \"type\": \"number\", \"required\": true, \"description\": \"Timestamp minus player clock in milliseconds\" },"
+        "\"dropped\": { \"type\": \"integer\", \"required\": true, \"description\": \"Frames or packets dropped so far\" },"
+        "\"duplicated\": { \"type\": \"integer\", \"required\": true, \"description\": \"Audio packets output twice, or video pictures repeated by the codec, so far\" },"
+        "\"level\": { \"type\": \"integer\", \"required\": true, \"description\": \"Fill level of the stream queue in percent\" }"
+      "}"
+    "}",
+    "\"Player.Telemetry\": {"
+      "\"type\": \"object\","
+      "\"properties\": {"
+        "\"video\": { \"type\": \"array\", \"items\": { \"$ref\": \"Player.Telemetry.Record\" }, \"required\": true },"
+        "\"audio\": { \"type\": \"array\", \"items\": { \"$ref\": \"Player.Telemetry.Record\" }, \"required\": true }"
+      "}"
+    "}",
     "\"Library.Id\": {"
       "\"type\": \"integer\","
       "\"default\": -1,"
@@ -973,6 +993,24 @@ namespace JSONRPC
       "],"
       "\"returns\": \"string\""
     "}",
+    "\"AudioPlayer.GetTelemetry\": {"
+      "\"type\": \"method\","
+      "\"description\": \"Retrieves the most recent timing records of the audio and video streams\","
+      "\"transport\": \"Response\","
+      "\"permission\": \"ReadData\","
+      "\"params\": ["
+        "{ \"name\": \"count\", \"type\": \"integer\", \"minimum\": 0, \"default\": 0, \"description\": \"Number of records per stream, 0 for all\" }"
+      "],"
+      "\"returns\": { \"$ref\": \"Player.Telemetry\" }"
+    "}",
+    "\"AudioPlayer.DumpTelemetry\": {"
+      "\"type\": \"method\","
+      "\"description\": \"Writes the timing records of the audio and video streams to a CSV file in the temp folder and returns its path\","
+      "\"transport\": \"Response\","
+      "\"permission\": \"Logging\","
+      "\"params\": [],"
+      "\"returns\": \"string\""
+    "}",
     "\"VideoPlayer.State\": {"
       "\"type\": \"method\","
       "\"description\": \"Returns playback state of the video player (if it is active)\","
@@ -1093,6 +1131,24 @@ namespace JSONRPC
       "],"
       "\"returns\": \"string\""
     "}",
+    "\"VideoPlayer.GetTelemetry\": {"
+      "\"type\": \"method\","
+      "\"description\": \"Retrieves the most recent timing records of the audio and video streams\","
+      "\"transport\": \"Response\","
+      "\"permission\": \"ReadData\","
+      "\"params\": ["
+        "{ \"name\": \"count\", \"type\": \"integer\", \"minimum\": 0, \"default\": 0, \"description\": \"Number of records per stream, 0 for all\" }"
+      "],"
+      "\"returns\": { \"$ref\": \"Player.Telemetry\" }"
+    "}",
+    "\"VideoPlayer.DumpTelemetry\": {"
+      "\"type\": \"method\","
+      "\"description\": \"Writes the timing records of the audio and video streams to a CSV file in the temp folder and returns its path\","
+      "\"transport\": \"Response\","
+      "\"permission\": \"Logging\","
+      "\"params\": [],"
+      "\"returns\": \"string\""
+    "}",
     "\"PicturePlayer.PlayPause\": {"
       "\"type\": \"method\","
       "\"description\": \"Pauses or unpause slideshow\","
@@ -116,6 +116,51 @@ void CEventButtonState::Load()
   }
 }
 
+/************************************************************************/
+/* CEventLatencyHistogram                                               */
+/************************************************************************/
+static const unsigned int LatencyBuckets[ES_LATENCY_BUCKETS - 1] = { 1, 2, 5, 10, 20, 50, 100, 200 };
+
+CEventLatencyHistogram::CEventLatencyHistogram()
+{
+  memset(m_buckets, 0, sizeof(m_buckets));
+  m_iCount = 0;
+  m_iTotal = 0;
+  m_iMax = 0;
+}
+
+void CEventLatencyHistogram::Add(unsigned int latency)
+{
+  unsigned int bucket = 0;
+  while (bucket < ES_LATENCY_BUCKETS - 1 && latency > LatencyBuckets[bucket])
+    bucket++;
+
+  m_buckets[bucket]++;
+  m_iCount++;
+  m_iTotal += latency;
+  if (latency > m_iMax)
+    m_iMax = latency;
+}
+
+string CEventLatencyHistogram::ToString() const
+{
+  if (m_iCount == 0)
+    return "no events";
+
+  CStdString result;
+  result.Format("%u events, avg %u ms, max %u ms |", m_iCount, m_iTotal / m_iCount, m_iMax);
+  for (unsigned int i = 0; i < ES_LATENCY_BUCKETS; i++)
+  {
+    CStdString bucket;
+    if (i < ES_LATENCY_BUCKETS - 1)
+      bucket.Format(" <=%ums: %u", LatencyBuckets[i], m_buckets[i]);
+    else
+      bucket.Format(" >%ums: %u", LatencyBuckets[i - 1], m_buckets[i]);
+    result += bucket;
+  }
+  return result;
+}
+
 /************************************************************************/
 /* CEventClient                                                         */
 /************************************************************************/
@@ -145,6 +190,7 @@ bool CEventClient::AddPacket(CEventPacket *packet)
         iSeqPayloadSize += m_seqPackets[i]->PayloadSize();
       }
       unsigned int offset = 0;
+      unsigned int received = packet->ReceivedTime(); // packet can be deleted below
       void *newPayload = NULL;
       newPayload = malloc(iSeqPayloadSize);
       if (newPayload)
@@ -163,6 +209,7 @@ bool CEventClient::AddPacket(CEventPacket *packet)
           }
         }
         m_seqPackets[1]->SetPayload(iSeqPayloadSize, newPayload);
+        m_seqPackets[1]->SetReceivedTime(received);
         m_readyPackets.push(m_seqPackets[1]);
         m_seqPackets.clear();
       }
@@ -187,6 +234,7 @@ void CEventClient::ProcessEvents()
   {
     while ( ! m_readyPackets.empty() )
     {
+      m_iPacketTime = m_readyPackets.front()->ReceivedTime();
       ProcessPacket( m_readyPackets.front() );
       if ( ! m_readyPackets.empty() ) // in case the BYE packet cleared the queues
       {
@@ -205,6 +253,8 @@ bool CEventClient::GetNextAction(CEventAction &action)
     // grab the next action in line
     action = m_actionQueue.front();
     m_actionQueue.pop();
+    if (action.receivedTime)
+      m_latency.Add(CTimeUtils::GetTimeMS() - action.receivedTime);
     LeaveCriticalSection(&m_critSection);
     return true;
   }
@@ -425,6 +475,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
                              (flags & (PTB_AXIS|PTB_AXISSINGLE)) ? true  : false,
                              (flags & PTB_NO_REPEAT)             ? false : true,
                              (flags & PTB_USE_AMOUNT)            ? true : false );
+    state.m_iReceivedTime = m_iPacketTime;
 
     /* correct non active events so they work with rest of code */
     if(!active)
@@ -490,6 +541,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
       m_currentButton.m_bRepeat    = (flags & PTB_NO_REPEAT)  ? false : true;
       m_currentButton.m_bAxis      = (flags & PTB_AXIS)       ? true : false;
       m_currentButton.m_iNextRepeat = 0;
+      m_currentButton.m_iReceivedTime = m_iPacketTime;
       m_currentButton.SetActive();
       m_currentButton.Load();
     }
@@ -506,6 +558,7 @@ bool CEventClient::OnPacketBUTTON(CEventPacket *packet)
                                  m_currentButton.m_bAxis,
                                  false,
                                  true );
+        state.m_iReceivedTime = m_iPacketTime;
 
         m_buttonQueue.push_back (state);
       }
@@ -651,7 +704,7 @@ bool CEventClient::OnPacketACTION(CEventPacket *packet)
   case AT_EXEC_BUILTIN:
   case AT_BUTTON:
     EnterCriticalSection(&m_critSection);
-    m_actionQueue.push(CEventAction(actionString.c_str(), actionType));
+    m_actionQueue.push(CEventAction(actionString.c_str(), actionType, m_iPacketTime));
     LeaveCriticalSection(&m_critSection);
     break;
 
@@ -744,6 +797,12 @@ unsigned short CEventClient::GetButtonCode(string& joystickName, bool& isAxis, f
     isAxis = m_currentButton.Axis();
     amount = m_currentButton.Amount();
 
+    if (m_currentButton.m_iReceivedTime)
+    {
+      m_latency.Add(CTimeUtils::GetTimeMS() - m_currentButton.m_iReceivedTime);
+      m_currentButton.m_iReceivedTime = 0;
+    }
+
     if ( ! m_currentButton.Repeat() )
       m_currentButton.Reset();
     else
@@ -778,7 +837,11 @@ unsigned short CEventClient::GetButtonCode(string& joystickName, bool& isAxis, f
         bcode = 0;
         continue;
       }
+      repeat.back().m_iReceivedTime = 0;
     }
+
+    if (bcode && it->m_iReceivedTime)
+      m_latency.Add(CTimeUtils::GetTimeMS() - it->m_iReceivedTime);
   }
 
   m_buttonQueue.erase(m_buttonQueue.begin(), it);
@@ -803,6 +866,12 @@ bool CEventClient::GetMousePos(float& x, float& y)
   return false;
 }
 
+void CEventClient::LogLatency()
+{
+  CSingleLock lock(m_critSection);
+  CLog::Log(LOGDEBUG, "ES: Input latency of client %s: %s", m_deviceName.c_str(), m_latency.ToString().c_str());
+}
+
 bool CEventClient::CheckButtonRepeat(unsigned int &next)
 {
   unsigned int now = CTimeUtils::GetTimeMS();
@@ -35,21 +35,46 @@
 namespace EVENTCLIENT
 {
 
+  /**********************************************************************/
+  /* Input-to-action latency histogram                                  */
+  /**********************************************************************/
+  // - buckets are upper bounds in ms, the last bucket collects the rest
+  #define ES_LATENCY_BUCKETS 9
+
+  class CEventLatencyHistogram
+  {
+  public:
+    CEventLatencyHistogram();
+
+    void Add(unsigned int latency);
+    unsigned int Count() const { return m_iCount; }
+    std::string ToString() const;
+
+  private:
+    unsigned int m_buckets[ES_LATENCY_BUCKETS];
+    unsigned int m_iCount;
+    unsigned int m_iTotal;
+    unsigned int m_iMax;
+  };
+
   class CEventAction
   {
   public:
     CEventAction()
     {
       actionType = 0;
+      receivedTime = 0;
     }
-    CEventAction(const char* action, unsigned char type)
+    CEventAction(const char* action, unsigned char type, unsigned int received = 0)
     {
       actionName = action;
       actionType = type;
+      receivedTime = received;
     }
 
     std::string    actionName;
     unsigned char  actionType;
+    unsigned int   receivedTime;
   };
 
   class CEventButtonState
@@ -67,6 +92,7 @@ namespace EVENTCLIENT
       m_bAxis      = false;
       m_iControllerNumber = 0;
       m_iNextRepeat = 0;
+      m_iReceivedTime = 0;
     }
 
     CEventButtonState(unsigned short iKeyCode,
@@ -88,6 +114,7 @@ namespace EVENTCLIENT
       m_bAxis      = isAxis;
       m_iControllerNumber = 0;
       m_iNextRepeat = 0;
+      m_iReceivedTime = 0;
       Load();
     }
 
@@ -114,6 +141,7 @@ namespace EVENTCLIENT
     bool              m_bActive;
     bool              m_bAxis;
     unsigned int      m_iNextRepeat;
+    unsigned int      m_iReceivedTime; // time the packet was received, 0 once handed out
   };
 
 
@@ -147,6 +175,7 @@ namespace EVENTCLIENT
       m_iRemotePort = 0;
       m_bMouseMoved = false;
       m_bSequenceError = false;
+      m_iPacketTime = 0;
       RefreshSettings();
     }
 
@@ -195,6 +224,9 @@ namespace EVENTCLIENT
     // update mouse position
     bool GetMousePos(float& x, float& y);
 
+    // log the input-to-action latency histogram of this client
+    void LogLatency();
+
   protected:
     bool ProcessPacket(EVENTPACKET::CEventPacket *packet);
 
@@ -248,6 +280,7 @@ namespace EVENTCLIENT
     unsigned int      m_iMouseY;
     bool              m_bMouseMoved;
     bool              m_bSequenceError;
+    unsigned int      m_iPacketTime; // receive time of the packet being processed
 
     SOCKETS::CAddress m_remoteAddr;
 
@@ -261,6 +294,7 @@ namespace EVENTCLIENT
     std::list<CEventButtonState>  m_buttonQueue;
     std::queue<CEventAction>      m_actionQueue;
     CEventButtonState m_currentButton;
+    CEventLatencyHistogram m_latency;
   };
 
 } // EVENTCLIENT
@@ -215,6 +215,7 @@ namespace EVENTPACKET
       m_cMajVer = '0';
       m_cMinVer = '0';
       m_eType = PT_LAST;
+      m_iReceivedTime = 0;
     }
 
     CEventPacket(int datasize, const void* data)
@@ -228,6 +229,7 @@ namespace EVENTPACKET
       m_cMajVer = '0';
       m_cMinVer = '0';
       m_eType = PT_LAST;
+      m_iReceivedTime = 0;
 
       Parse(datasize, data);
     }
@@ -241,6 +243,8 @@ namespace EVENTPACKET
     void*        Payload() { return m_pPayload; }
     unsigned int PayloadSize() const { return m_iPayloadSize; }
     unsigned int ClientToken() const { return m_iClientToken; }
+    unsigned int ReceivedTime() const { return m_iReceivedTime; }
+    void         SetReceivedTime(unsigned int time) { m_iReceivedTime = time; }
     void         SetPayload(unsigned int psize, void *payload)
     {
       free(m_pPayload);
@@ -259,6 +263,7 @@ namespace EVENTPACKET
     unsigned char  m_cMajVer;
     unsigned char  m_cMinVer;
     PacketType     m_eType;
+    unsigned int   m_iReceivedTime;
   };
 
 }
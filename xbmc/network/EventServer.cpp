@@ -34,9 +34,13 @@
 #include "threads/SingleLock.h"
 #include "Zeroconf.h"
 #include "guilib/GUIAudioManager.h"
+#include "utils/TimeUtils.h"
 #include <map>
 #include <queue>
 
+// maximum number of packets read in one go before the events are processed
+#define MAX_PACKET_BATCH 64
+
 using namespace EVENTSERVER;
 using namespace EVENTPACKET;
 using namespace EVENTCLIENT;
@@ -128,6 +132,7 @@ void CEventServer::Cleanup()
   {
     if (iter->second)
     {
+      iter->second->LogLatency();
       delete iter->second;
     }
     m_clients.erase(iter);
@@ -204,13 +209,20 @@ void CEventServer::Run()
   {
     try
     {
-      // start listening until we timeout
+      // start listening until we timeout, then drain all pending packets
+      // so a burst from several clients is handled in one pass
       if (listener.Listen(m_iListenTimeout))
       {
-        CAddress addr;
-        if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, (void *)m_pPacketBuffer)) > -1)
+        for (int i = 0; i < MAX_PACKET_BATCH; i++)
         {
-          ProcessPacket(addr, packetSize);
+          CAddress addr;
+          if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, (void *)m_pPacketBuffer)) > -1)
+          {
+            ProcessPacket(addr, packetSize);
+          }
+
+          if (!listener.Listen(0))
+            break;
         }
       }
     }
@@ -246,6 +258,7 @@ void CEventServer::ProcessPacket(CAddress& addr, int pSize)
   }
 
   unsigned int clientToken;
+  packet->SetReceivedTime(CTimeUtils::GetTimeMS());
 
   if (!packet->IsValid())
   {
@@ -297,6 +310,7 @@ void CEventServer::RefreshClients()
     {
       CLog::Log(LOGNOTICE, "ES: Client %s from %s timed out", iter->second->Name().c_str(),
                 iter->second->Address().Address());
+      iter->second->LogLatency();
       delete iter->second;
       m_clients.erase(iter);
       iter = m_clients.begin();
@@ -120,6 +120,7 @@ void CTCPServer::Process()
           if (nread <= 0)
           {
             CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+            CSingleLock lock (m_connectionsSection);
             m_connections[i].Disconnect();
             m_connections.erase(m_connections.begin() + i);
           }
@@ -139,6 +140,7 @@ void CTCPServer::Process()
           else
           {
             CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+            CSingleLock lock (m_connectionsSection);
             m_connections.push_back(newconnection);
           }
         }
@@ -163,6 +165,7 @@ void CTCPServer::Announce(EAnnouncementFlag flag, const char *sender, const char
 {
   std::string str = AnnouncementToJSON(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact);
 
+  CSingleLock connectionsLock (m_connectionsSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
     {
@@ -191,7 +194,7 @@ bool CTCPServer::Initialize()
 
   if(started)
   {
-    CAnnouncementManager::AddAnnouncer(this);
+    CAnnouncementManager::AddAnnouncer(this, true);
     CLog::Log(LOGINFO, "JSONRPC Server: Successfully initialized");
     return true;
   }
@@ -420,10 +423,15 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
+  // waits for a running Announce, so it must not be called with m_connectionsSection held
+  CAnnouncementManager::RemoveAnnouncer(this);
+
+  CSingleLock lock (m_connectionsSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
     m_connections[i].Disconnect();
 
   m_connections.clear();
+  lock.Leave();
 
   for (unsigned int i = 0; i < m_servers.size(); i++)
     closesocket(m_servers[i]);
@@ -435,8 +443,6 @@ void CTCPServer::Deinitialize()
     sdp_close( (sdp_session_t*)m_sdpd );
   m_sdpd = NULL;
 #endif
-
-  CAnnouncementManager::RemoveAnnouncer(this);
 }
 
 CTCPServer::CTCPClient::CTCPClient()
@@ -504,9 +510,8 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
         m_endBrackets++;
       if (m_beginBrackets > 0 && m_endBrackets > 0 && m_beginBrackets == m_endBrackets)
       {
-        std::string line = CJSONRPC::MethodCall(m_buffer, host, this);
-        CSingleLock lock (m_critSection);
-        send(m_socket, line.c_str(), line.size(), 0);
+        CSocketWriter writer(m_socket, m_critSection);
+        CJSONRPC::MethodCall(m_buffer, host, this, &writer);
         m_beginChar = m_beginBrackets = m_endBrackets = 0;
         m_buffer.clear();
       }
@@ -514,6 +519,23 @@ void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, in
   }
 }
 
+bool CTCPServer::CTCPClient::CSocketWriter::OnWrite(const char *data, unsigned int length)
+{
+  if (!m_lock.IsOwner())
+    m_lock.Enter();
+
+  unsigned int sent = 0;
+  while (sent < length)
+  {
+    int res = send(m_socket, data + sent, length - sent, 0);
+    if (res <= 0)
+      return false;
+    sent += res;
+  }
+
+  return true;
+}
+
 void CTCPServer::CTCPClient::Disconnect()
 {
   if (m_socket > 0)
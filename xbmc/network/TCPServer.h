@@ -5,7 +5,9 @@
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "threads/Thread.h"
 #include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "interfaces/json-rpc/JSONUtils.h"
+#include "utils/JSONVariantWriter.h"
 
 namespace JSONRPC
 {
@@ -48,6 +50,22 @@ namespace JSONRPC
       CCriticalSection m_critSection;
 
     private:
+      /*!
+       \brief Sends serialized output straight to the client socket. The
+       client lock is only taken once output starts so that announcements
+       raised while handling the request are not blocked but can't
+       interleave with the response either.
+       */
+      class CSocketWriter : public IJSONWriteCallback
+      {
+      public:
+        CSocketWriter(SOCKET socket, CCriticalSection &section) : m_socket(socket), m_lock(section) { m_lock.Leave(); }
+        virtual bool OnWrite(const char *data, unsigned int length);
+      private:
+        SOCKET m_socket;
+        CSingleLock m_lock;
+      };
+
       void Copy(const CTCPClient& client);
       int m_announcementflags;
       int m_beginBrackets, m_endBrackets;
@@ -56,6 +74,8 @@ namespace JSONRPC
     };
 
     std::vector<CTCPClient> m_connections;
+    // guards m_connections against the announcement dispatch thread
+    CCriticalSection m_connectionsSection;
     std::vector<SOCKET> m_servers;
     int m_port;
     bool m_nonlocal;
@@ -32,6 +32,7 @@
 #include "threads/SingleLock.h"
 #include "XBDateTime.h"
 #include "addons/AddonManager.h"
+#include <algorithm>
 
 #ifdef _WIN32
 #pragma comment(lib, "../../lib/win32/libmicrohttpd_win32/lib/libmicrohttpd.dll.lib")
@@ -253,11 +254,17 @@ int CWebServer::JSONRPC(CWebServer *server, void **con_cls, struct MHD_Connectio
     CStdString *jsoncall = (CStdString *)(*con_cls);
 
     CHTTPClient client;
-    CStdString jsonresponse = CJSONRPC::MethodCall(*jsoncall, server, &client);
-
-    struct MHD_Response *response = MHD_create_response_from_data(jsonresponse.length(), (void *) jsonresponse.c_str(), MHD_NO, MHD_YES);
-    int ret = MHD_queue_response(connection, MHD_HTTP_OK, response);
+    CJSONRPCResponse *jsonresponse = new CJSONRPCResponse();
+    CJSONRPC::MethodCall(*jsoncall, server, &client, jsonresponse);
+
+    // the response chunks are passed on (and freed) by libmicrohttpd as they
+    // are sent instead of being copied into one contiguous buffer
+    struct MHD_Response *response = MHD_create_response_from_callback(jsonresponse->GetLength(),
+                                                                      16384,
+                                                                      &CWebServer::JSONRPCReaderCallback, jsonresponse,
+                                                                      &CWebServer::JSONRPCReaderFreeCallback);
     MHD_add_response_header(response, "Content-Type", "application/json");
+    int ret = MHD_queue_response(connection, MHD_HTTP_OK, response);
     MHD_destroy_response(response);
 
     delete jsoncall;
@@ -418,6 +425,57 @@ void CWebServer::ContentReaderFreeCallback(void *cls)
   delete file;
 }
 
+#if (MHD_VERSION >= 0x00090200)
+ssize_t CWebServer::JSONRPCReaderCallback(void *cls, uint64_t pos, char *buf, size_t max)
+#elif (MHD_VERSION >= 0x00040001)
+int CWebServer::JSONRPCReaderCallback(void *cls, uint64_t pos, char *buf, int max)
+#else   //libmicrohttpd < 0.4.0
+int CWebServer::JSONRPCReaderCallback(void *cls, size_t pos, char *buf, int max)
+#endif
+{
+  CJSONRPCResponse *response = (CJSONRPCResponse *)cls;
+  size_t res = response->Read(buf, max);
+  if (res == 0)
+    return -1;
+  return res;
+}
+
+void CWebServer::JSONRPCReaderFreeCallback(void *cls)
+{
+  CJSONRPCResponse *response = (CJSONRPCResponse *)cls;
+  delete response;
+}
+
+bool CWebServer::CJSONRPCResponse::OnWrite(const char *data, unsigned int length)
+{
+  m_chunks.push_back(std::string(data, length));
+  m_length += length;
+  return true;
+}
+
+size_t CWebServer::CJSONRPCResponse::Read(char *buf, size_t max)
+{
+  // libmicrohttpd reads the content sequentially so already sent
+  // chunks can be released right away
+  size_t read = 0;
+  while (read < max && !m_chunks.empty())
+  {
+    const std::string &chunk = m_chunks.front();
+    size_t size = std::min(chunk.size() - m_offset, max - read);
+    memcpy(buf + read, chunk.c_str() + m_offset, size);
+    read += size;
+    m_offset += size;
+
+    if (m_offset >= chunk.size())
+    {
+      m_chunks.pop_front();
+      m_offset = 0;
+    }
+  }
+
+  return read;
+}
+
 struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 {
   // WARNING: when using MHD_USE_THREAD_PER_CONNECTION, set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
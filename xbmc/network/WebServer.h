@@ -37,6 +37,9 @@
 #endif
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "threads/CriticalSection.h"
+#include "utils/JSONVariantWriter.h"
+#include <deque>
+#include <string>
 
 class CWebServer : public JSONRPC::ITransportLayer
 {
@@ -83,6 +86,15 @@ private:
                         unsigned int *upload_data_size, void **con_cls);
 #endif
   static void ContentReaderFreeCallback (void *cls);
+
+#if (MHD_VERSION >= 0x00090200)
+  static ssize_t JSONRPCReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
+#elif (MHD_VERSION >= 0x00040001)
+  static int JSONRPCReaderCallback (void *cls, uint64_t pos, char *buf, int max);
+#else
+  static int JSONRPCReaderCallback (void *cls, size_t pos, char *buf, int max);
+#endif
+  static void JSONRPCReaderFreeCallback (void *cls);
   static int HttpApi(struct MHD_Connection *connection);
   static HTTPMethod GetMethod(const char *method);
   static int CreateRedirect(struct MHD_Connection *connection, const CStdString &strURL);
@@ -101,6 +113,27 @@ private:
   CStdString m_Credentials64Encoded;
   CCriticalSection m_critSection;
 
+  /*!
+   \brief Holds a serialized JSON RPC response as a list of chunks which
+   are handed to libmicrohttpd (and released) one by one
+
+   The whole response is serialized before it is queued, this only saves
+   the contiguous copy libmicrohttpd would otherwise make of it.
+   */
+  class CJSONRPCResponse : public IJSONWriteCallback
+  {
+  public:
+    CJSONRPCResponse() : m_length(0), m_offset(0) { }
+    virtual bool OnWrite(const char *data, unsigned int length);
+    size_t GetLength() const { return m_length; }
+    size_t Read(char *buf, size_t max);
+
+  private:
+    std::deque<std::string> m_chunks;
+    size_t m_length;
+    size_t m_offset;
+  };
+
   class CHTTPClient : public JSONRPC::IClient
   {
   public:
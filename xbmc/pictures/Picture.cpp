@@ -46,16 +46,13 @@ bool CPicture::CacheImage(const CStdString& sourceUrl, const CStdString& destFil
   {
     CLog::Log(LOGINFO, "Caching image from: %s to %s with width %i and height %i", sourceUrl.c_str(), destFile.c_str(), width, height);
     
-    DllImageLib dll;
-    if (!dll.Load()) return false;
-
     if (URIUtils::IsInternetStream(sourceUrl, true))
     {
       CFileCurl http;
       CStdString data;
       if (http.Get(sourceUrl, data))
       {
-        if (!dll.CreateThumbnailFromMemory((BYTE *)data.c_str(), data.GetLength(), URIUtils::GetExtension(sourceUrl).c_str(), destFile.c_str(), width, height))
+        if (!CacheImageFromMemory((const unsigned char *)data.c_str(), data.GetLength(), URIUtils::GetExtension(sourceUrl), destFile, width, height))
         {
           CLog::Log(LOGERROR, "%s Unable to create new image %s from image %s", __FUNCTION__, destFile.c_str(), sourceUrl.c_str());
           return false;
@@ -65,6 +62,9 @@ bool CPicture::CacheImage(const CStdString& sourceUrl, const CStdString& destFil
       return false;
     }
 
+    DllImageLib dll;
+    if (!dll.Load()) return false;
+
     if (!dll.CreateThumbnail(sourceUrl.c_str(), destFile.c_str(), width, height, g_guiSettings.GetBool("pictures.useexifrotation")))
     {
       CLog::Log(LOGERROR, "%s Unable to create new image %s from image %s", __FUNCTION__, destFile.c_str(), sourceUrl.c_str());
@@ -84,15 +84,45 @@ bool CPicture::CacheThumb(const CStdString& sourceUrl, const CStdString& destFil
   return CacheImage(sourceUrl, destFile, g_advancedSettings.m_thumbSize, g_advancedSettings.m_thumbSize);
 }
 
-bool CPicture::CacheFanart(const CStdString& sourceUrl, const CStdString& destFile)
+bool CPicture::CacheImageFromMemory(const unsigned char* buffer, int bufSize, const CStdString& extension, const CStdString& destFile, int width, int height)
 {
-  int height = g_advancedSettings.m_fanartHeight;
+  if (width > 0 && height > 0)
+  {
+    DllImageLib dll;
+    if (!dll.Load()) return false;
+    return dll.CreateThumbnailFromMemory((BYTE *)buffer, bufSize, extension.c_str(), destFile.c_str(), width, height);
+  }
+
+  // no size to scale to, keep the image as it is
+  CFile file;
+  if (!file.OpenForWrite(destFile, true))
+    return false;
+  bool result = file.Write(buffer, bufSize) == bufSize;
+  file.Close();
+  return result;
+}
+
+static void GetFanartSize(int &width, int &height)
+{
+  height = g_advancedSettings.m_fanartHeight;
   // Assume 16:9 size
-  int width = height * 16 / 9;
+  width = height * 16 / 9;
+}
 
+bool CPicture::CacheFanart(const CStdString& sourceUrl, const CStdString& destFile)
+{
+  int width, height;
+  GetFanartSize(width, height);
   return CacheImage(sourceUrl, destFile, width, height);
 }
 
+bool CPicture::CacheFanartFromMemory(const unsigned char* buffer, int bufSize, const CStdString& extension, const CStdString& destFile)
+{
+  int width, height;
+  GetFanartSize(width, height);
+  return CacheImageFromMemory(buffer, bufSize, extension, destFile, width, height);
+}
+
 bool CPicture::CreateThumbnailFromMemory(const unsigned char* buffer, int bufSize, const CStdString& extension, const CStdString& thumbFile)
 {
   CLog::Log(LOGINFO, "Creating album thumb from memory: %s", thumbFile.c_str());
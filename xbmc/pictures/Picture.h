@@ -33,9 +33,11 @@ public:
   static bool CreateThumbnail(const CStdString& file, const CStdString& thumbFile, bool checkExistence = false);
   static bool CacheThumb(const CStdString& sourceUrl, const CStdString& destFile);
   static bool CacheFanart(const CStdString& SourceUrl, const CStdString& destFile);
+  static bool CacheFanartFromMemory(const unsigned char* buffer, int bufSize, const CStdString& extension, const CStdString& destFile);
 
 private:
   static bool CacheImage(const CStdString& sourceUrl, const CStdString& destFile, int width, int height);
+  static bool CacheImageFromMemory(const unsigned char* buffer, int bufSize, const CStdString& extension, const CStdString& destFile, int width, int height);
 };
 
 //this class calls CreateThumbnailFromSurface in a CJob, so a png file can be written without halting the render thread
@@ -89,6 +89,8 @@ void CAdvancedSettings::Initialize()
   m_videoAllowLanczos3 = false;
   m_videoAutoScaleMaxFps = 30.0f;
   m_videoAllowMpeg4VDPAU = false;
+  m_videoMaxSkipLevel = 3;
+  m_videoDecodeThreads = 0;
   m_DXVACheckCompatibility = false;
   m_DXVACheckCompatibilityPresent = false;
 
@@ -102,6 +104,9 @@ void CAdvancedSettings::Initialize()
   m_musicPercentSeekForwardBig = 10;
   m_musicPercentSeekBackwardBig = -10;
   m_musicResample = 0;
+  m_musicDecodeAheadTracks = 2;
+  m_musicDecodeAheadBuffer = 16384;
+  m_musicFloatOutput = true;
 
   m_slideshowPanAmount = 2.5f;
   m_slideshowZoomAmount = 5.0f;
@@ -173,6 +178,10 @@ void CAdvancedSettings::Initialize()
   m_thumbSize = DEFAULT_THUMB_SIZE;
   m_fanartHeight = DEFAULT_FANART_HEIGHT;
   m_useDDSFanart = false;
+  m_ddsThreads = 0;
+  m_ddsFastCompression = false;
+  m_artworkCacheThreads = 4;
+  m_artworkCacheMaxBandwidth = 0;
 
   m_sambaclienttimeout = 10;
   m_sambadoscodepage = "";
@@ -293,6 +302,8 @@ void CAdvancedSettings::Initialize()
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 0;
+  m_guiWindowMemory = 4096;
+  m_guiPreloadWindows = 2;
 }
 
 bool CAdvancedSettings::Load()
@@ -361,6 +372,9 @@ void CAdvancedSettings::ParseSettingsFile(const CStdString &file)
     XMLUtils::GetInt(pElement, "percentseekbackwardbig", m_musicPercentSeekBackwardBig, -100, 0);
 
     XMLUtils::GetInt(pElement, "resample", m_musicResample, 0, 192000);
+    XMLUtils::GetInt(pElement, "decodeaheadtracks", m_musicDecodeAheadTracks, 0, 8);
+    XMLUtils::GetInt(pElement, "decodeaheadbuffer", m_musicDecodeAheadBuffer, 0, 262144);
+    XMLUtils::GetBoolean(pElement, "floatoutput", m_musicFloatOutput);
 
     TiXmlElement* pAudioExcludes = pElement->FirstChildElement("excludefromlisting");
     if (pAudioExcludes)
@@ -452,6 +466,10 @@ void CAdvancedSettings::ParseSettingsFile(const CStdString &file)
     XMLUtils::GetBoolean(pElement,"allowlanczos3",m_videoAllowLanczos3);
     XMLUtils::GetFloat(pElement,"autoscalemaxfps",m_videoAutoScaleMaxFps, 0.0f, 1000.0f);
     XMLUtils::GetBoolean(pElement,"allowmpeg4vdpau",m_videoAllowMpeg4VDPAU);
+    // how far the decoder may lower quality when late, 0 disables, see VC_SKIP_ levels
+    XMLUtils::GetInt(pElement,"maxskiplevel",m_videoMaxSkipLevel, 0, 3);
+    // upper limit for software decoding threads, 0 uses all cpus, 1 disables threading
+    XMLUtils::GetInt(pElement,"decodethreads",m_videoDecodeThreads, 0, 16);
 
     TiXmlElement* pAdjustRefreshrate = pElement->FirstChildElement("adjustrefreshrate");
     if (pAdjustRefreshrate)
@@ -827,6 +845,15 @@ void CAdvancedSettings::ParseSettingsFile(const CStdString &file)
   XMLUtils::GetInt(pRootElement, "thumbsize", m_thumbSize, 0, 1024);
   XMLUtils::GetInt(pRootElement, "fanartheight", m_fanartHeight, 0, 1080);
   XMLUtils::GetBoolean(pRootElement, "useddsfanart", m_useDDSFanart);
+  XMLUtils::GetInt(pRootElement, "ddsthreads", m_ddsThreads, 0, 16);
+  XMLUtils::GetBoolean(pRootElement, "ddsfastcompression", m_ddsFastCompression);
+
+  TiXmlElement *pArtworkCache = pRootElement->FirstChildElement("artworkcache");
+  if (pArtworkCache)
+  {
+    XMLUtils::GetInt(pArtworkCache, "threads", m_artworkCacheThreads, 1, 16);
+    XMLUtils::GetInt(pArtworkCache, "maxbandwidth", m_artworkCacheMaxBandwidth, 0, 1000000);
+  }
 
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
@@ -952,6 +979,8 @@ void CAdvancedSettings::ParseSettingsFile(const CStdString &file)
   {
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
+    XMLUtils::GetInt(pElement, "windowmemory",              m_guiWindowMemory, 0, 65536);
+    XMLUtils::GetInt(pElement, "preloadwindows",            m_guiPreloadWindows, 0, 8);
   }
 
   // load in the GUISettings overrides:
@@ -109,6 +109,9 @@ class CAdvancedSettings
     int m_musicPercentSeekForwardBig;
     int m_musicPercentSeekBackwardBig;
     int m_musicResample;
+    int m_musicDecodeAheadTracks;
+    int m_musicDecodeAheadBuffer;
+    bool m_musicFloatOutput;
     int m_videoBlackBarColour;
     int m_videoIgnoreSecondsAtStart;
     float m_videoIgnorePercentAtEnd;
@@ -120,6 +123,8 @@ class CAdvancedSettings
     bool  m_videoAllowLanczos3;
     float m_videoAutoScaleMaxFps;
     bool  m_videoAllowMpeg4VDPAU;
+    int   m_videoMaxSkipLevel;
+    int   m_videoDecodeThreads;
     std::vector<RefreshOverride> m_videoAdjustRefreshOverrides;
     bool m_DXVACheckCompatibility;
     bool m_DXVACheckCompatibilityPresent;
@@ -179,6 +184,10 @@ class CAdvancedSettings
     int m_thumbSize;
     int m_fanartHeight;
     bool m_useDDSFanart;
+    int m_ddsThreads; ///< 0 to use all cores
+    bool m_ddsFastCompression;
+    int m_artworkCacheThreads;
+    int m_artworkCacheMaxBandwidth; ///< KB/s, 0 for unlimited
 
     int m_sambaclienttimeout;
     CStdString m_sambadoscodepage;
@@ -301,6 +310,8 @@ class CAdvancedSettings
 
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
+    int  m_guiWindowMemory;    // memory in kB for holding the skin xml of windows between loads, 0 to disable
+    int  m_guiPreloadWindows;  // number of windows likely to be shown next that are read ahead
 
     unsigned int m_cacheMemBufferSize;
 
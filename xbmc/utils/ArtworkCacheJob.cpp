@@ -0,0 +1,333 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "ArtworkCacheJob.h"
+#include "FileItem.h"
+#include "Util.h"
+#include "filesystem/File.h"
+#include "music/Album.h"
+#include "music/Artist.h"
+#include "music/MusicDatabase.h"
+#include "music/tags/MusicInfoTag.h"
+#include "pictures/Picture.h"
+#include "threads/SingleLock.h"
+#include "utils/Fanart.h"
+#include "utils/log.h"
+#include "utils/ScraperUrl.h"
+#include "utils/TimeUtils.h"
+#include "utils/URIUtils.h"
+#include "video/VideoDatabase.h"
+#include "video/VideoInfoTag.h"
+
+using namespace std;
+using namespace XFILE;
+
+CArtworkCacheJob::CArtworkCacheJob(int flags, unsigned int threads, unsigned int maxBandwidth)
+{
+  m_flags = flags;
+  m_threads = threads ? threads : 1;
+  m_maxBandwidth = maxBandwidth;
+  m_next = 0;
+  m_done = 0;
+  m_failed = 0;
+  m_skipped = 0;
+  m_bytes = 0;
+  m_startTime = 0;
+  m_cancelled = false;
+}
+
+bool CArtworkCacheJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CArtworkCacheJob* cacheJob = dynamic_cast<const CArtworkCacheJob*>(job);
+    if (cacheJob && cacheJob->m_flags == m_flags)
+      return true;
+  }
+  return false;
+}
+
+bool CArtworkCacheJob::DoWork()
+{
+  if (m_flags & ArtworkVideo)
+    CollectVideoArtwork();
+  if (m_flags & ArtworkMusic)
+    CollectMusicArtwork();
+
+  CLog::Log(LOGNOTICE, "%s - %u images to cache, %u already cached, using %u threads",
+            __FUNCTION__, (unsigned int)m_artwork.size(), m_skipped, m_threads);
+  if (m_artwork.empty())
+    return true;
+
+  m_startTime = CTimeUtils::GetTimeMS();
+
+  CWorker worker(this);
+  vector<CThread *> threads;
+  for (unsigned int i = 0; i < m_threads && i < m_artwork.size(); i++)
+  {
+    CThread *thread = new CThread(&worker, "ArtworkCacheWorker");
+    thread->Create();
+    threads.push_back(thread);
+  }
+
+  // report progress and check for cancellation while the workers are busy
+  unsigned int lastLog = m_startTime;
+  while (true)
+  {
+    unsigned int done;
+    {
+      CSingleLock lock(m_section);
+      done = m_done;
+    }
+    if (done >= m_artwork.size())
+      break;
+
+    if (ShouldCancel(done, m_artwork.size()))
+    {
+      m_cancelled = true;
+      break;
+    }
+
+    if (CTimeUtils::GetTimeMS() - lastLog > 10000)
+    {
+      LogProgress("progress");
+      lastLog = CTimeUtils::GetTimeMS();
+    }
+    Sleep(200);
+  }
+
+  for (unsigned int i = 0; i < threads.size(); i++)
+  {
+    threads[i]->StopThread();
+    delete threads[i];
+  }
+
+  LogProgress(m_cancelled ? "cancelled" : "finished");
+  return !m_cancelled;
+}
+
+void CArtworkCacheJob::CollectVideoArtwork()
+{
+  CVideoDatabase db;
+  if (!db.Open())
+    return;
+
+  CFileItemList items;
+  if (db.GetMoviesNav("videodb://1/2/", items))
+  {
+    for (int i = 0; i < items.Size(); i++)
+      AddVideoItem(*items[i]);
+  }
+  items.Clear();
+
+  if (db.GetTvShowsNav("videodb://2/2/", items))
+  {
+    for (int i = 0; i < items.Size(); i++)
+      AddVideoItem(*items[i]);
+  }
+  items.Clear();
+
+  if (db.GetEpisodesNav("videodb://2/2/-1/-1/", items))
+  {
+    for (int i = 0; i < items.Size(); i++)
+      AddVideoItem(*items[i]);
+  }
+  items.Clear();
+
+  if (db.GetMusicVideosNav("videodb://3/2/", items))
+  {
+    for (int i = 0; i < items.Size(); i++)
+      AddVideoItem(*items[i]);
+  }
+
+  db.Close();
+}
+
+void CArtworkCacheJob::AddVideoItem(const CFileItem &item)
+{
+  if (!item.HasVideoInfoTag())
+    return;
+
+  const CVideoInfoTag *tag = item.GetVideoInfoTag();
+  bool isEpisode = !item.m_bIsFolder && tag->m_iEpisode > -1;
+
+  // episodes share the fanart of their show
+  if (!isEpisode)
+  {
+    CFanart fanart(tag->m_fanart);
+    if (fanart.Unpack() && fanart.GetNumFanarts())
+      AddArtwork(fanart.GetImageURL(), item.GetCachedFanart(), false);
+  }
+
+  CStdString thumb = CScraperUrl::GetThumbURL(tag->m_strPictureURL.GetFirstThumb());
+  // relative thumbs are only resolved while scanning
+  if (thumb.Find("://") < 0)
+    return;
+
+  AddArtwork(thumb, isEpisode ? item.GetCachedEpisodeThumb() : item.GetCachedVideoThumb(), true);
+}
+
+void CArtworkCacheJob::CollectMusicArtwork()
+{
+  CMusicDatabase db;
+  if (!db.Open())
+    return;
+
+  CFileItemList items;
+  if (db.GetAlbumsNav("musicdb://3/", items, -1, -1, -1, -1))
+  {
+    for (int i = 0; i < items.Size(); i++)
+    {
+      CAlbum album;
+      if (!db.GetAlbumInfo(items[i]->GetMusicInfoTag()->GetDatabaseId(), album, NULL) || album.thumbURL.m_url.empty())
+        continue;
+
+      AddArtwork(CScraperUrl::GetThumbURL(album.thumbURL.m_url[0]), CUtil::GetCachedAlbumThumb(album.strAlbum, album.strArtist), true);
+    }
+  }
+  items.Clear();
+
+  if (db.GetArtistsNav("musicdb://2/", items, -1, false))
+  {
+    for (int i = 0; i < items.Size(); i++)
+    {
+      CArtist artist;
+      if (!db.GetArtistInfo(items[i]->GetMusicInfoTag()->GetDatabaseId(), artist, false))
+        continue;
+
+      CFileItem item(artist.strArtist);
+      if (!artist.thumbURL.m_url.empty())
+        AddArtwork(CScraperUrl::GetThumbURL(artist.thumbURL.m_url[0]), item.GetCachedArtistThumb(), true);
+
+      item.GetMusicInfoTag()->SetArtist(artist.strArtist);
+      if (artist.fanart.GetNumFanarts())
+        AddArtwork(artist.fanart.GetImageURL(), item.GetCachedFanart(), false);
+    }
+  }
+
+  db.Close();
+}
+
+void CArtworkCacheJob::AddArtwork(const CStdString &url, const CStdString &cachedFile, bool thumb)
+{
+  if (url.IsEmpty() || cachedFile.IsEmpty())
+    return;
+
+  // several items may share the same image (e.g. fanart of a show)
+  if (!m_queued.insert(cachedFile).second)
+    return;
+
+  if (CFile::Exists(cachedFile))
+  {
+    m_skipped++;
+    return;
+  }
+
+  Artwork artwork;
+  artwork.url = url;
+  artwork.cachedFile = cachedFile;
+  artwork.thumb = thumb;
+  m_artwork.push_back(artwork);
+}
+
+void CArtworkCacheJob::Process()
+{
+  while (!m_cancelled)
+  {
+    Artwork artwork;
+    {
+      CSingleLock lock(m_section);
+      if (m_next >= m_artwork.size())
+        return;
+      artwork = m_artwork[m_next++];
+    }
+
+    int64_t bytes = 0;
+    bool success = CacheArtwork(artwork, bytes);
+
+    {
+      CSingleLock lock(m_section);
+      m_done++;
+      if (!success)
+        m_failed++;
+      m_bytes += bytes;
+    }
+
+    Throttle(bytes);
+  }
+}
+
+bool CArtworkCacheJob::CacheArtwork(const Artwork &artwork, int64_t &bytes) const
+{
+  // fetch the image ourselves, so the bytes actually read feed both the
+  // bandwidth cap and the progress stats
+  CStdString data;
+  CFile file;
+  if (file.Open(artwork.url))
+  {
+    char buffer[65536];
+    unsigned int read;
+    while ((read = file.Read(buffer, sizeof(buffer))) > 0)
+      data.append(buffer, read);
+    file.Close();
+  }
+  bytes = data.size();
+
+  CStdString extension = URIUtils::GetExtension(artwork.url);
+  bool result = !data.IsEmpty() &&
+                (artwork.thumb ? CPicture::CreateThumbnailFromMemory((const unsigned char *)data.c_str(), data.size(), extension, artwork.cachedFile)
+                               : CPicture::CacheFanartFromMemory((const unsigned char *)data.c_str(), data.size(), extension, artwork.cachedFile));
+  if (!result)
+  {
+    CLog::Log(LOGDEBUG, "%s - failed to cache %s", __FUNCTION__, artwork.url.c_str());
+    CFile::Delete(artwork.cachedFile);
+  }
+  return result;
+}
+
+void CArtworkCacheJob::Throttle(int64_t bytes)
+{
+  if (!m_maxBandwidth || !bytes)
+    return;
+
+  int64_t total;
+  {
+    CSingleLock lock(m_section);
+    total = m_bytes;
+  }
+
+  // time the downloaded amount should have taken at the maximum rate
+  unsigned int expected = (unsigned int)(total * 1000 / ((int64_t)m_maxBandwidth * 1024));
+  unsigned int elapsed = CTimeUtils::GetTimeMS() - m_startTime;
+  if (expected > elapsed)
+    Sleep(expected - elapsed);
+}
+
+void CArtworkCacheJob::LogProgress(const char *prefix) const
+{
+  unsigned int elapsed = CTimeUtils::GetTimeMS() - m_startTime;
+  float seconds = elapsed ? elapsed / 1000.0f : 1.0f;
+
+  CSingleLock lock(m_section);
+  CLog::Log(LOGNOTICE, "%s - %s: %u of %u images (%u failed) in %.1fs, %.2f images/s, %.1f KB/s",
+            __FUNCTION__, prefix, m_done, (unsigned int)m_artwork.size(), m_failed, seconds,
+            m_done / seconds, m_bytes / 1024.0f / seconds);
+}
@@ -0,0 +1,103 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "Job.h"
+#include "utils/StdString.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+#include <set>
+#include <vector>
+
+class CFileItem;
+
+enum EArtworkCacheFlag
+{
+  ArtworkVideo = 0x1,
+  ArtworkMusic = 0x2
+};
+
+/*!
+ \ingroup textures
+ \brief Job to pre-cache the thumbs and fanart of the whole library
+
+ Walks the video and music databases for scraped thumb and fanart URLs whose
+ cached image doesn't exist yet, and downloads and resizes them using a
+ number of worker threads. The overall download rate can be capped, and the
+ progress and throughput are reported via OnJobProgress and the log.
+ */
+class CArtworkCacheJob : public CJob
+{
+public:
+  /*!
+   \brief Create a job to cache the artwork of the given libraries
+   \param flags combination of EArtworkCacheFlag values
+   \param threads number of images processed in parallel
+   \param maxBandwidth maximum download rate in KB/s, 0 for unlimited
+   */
+  CArtworkCacheJob(int flags, unsigned int threads, unsigned int maxBandwidth);
+
+  virtual const char *GetType() const { return "cacheartwork"; };
+  virtual bool operator==(const CJob *job) const;
+  virtual bool DoWork();
+
+private:
+  typedef struct
+  {
+    CStdString url;
+    CStdString cachedFile;
+    bool       thumb;
+  } Artwork;
+
+  class CWorker : public IRunnable
+  {
+  public:
+    CWorker(CArtworkCacheJob *job) : m_job(job) { };
+    virtual void Run() { m_job->Process(); };
+  private:
+    CArtworkCacheJob *m_job;
+  };
+
+  void CollectVideoArtwork();
+  void CollectMusicArtwork();
+  void AddVideoItem(const CFileItem &item);
+  void AddArtwork(const CStdString &url, const CStdString &cachedFile, bool thumb);
+
+  void Process();
+  bool CacheArtwork(const Artwork &artwork, int64_t &bytes) const;
+  void Throttle(int64_t bytes);
+  void LogProgress(const char *prefix) const;
+
+  int          m_flags;
+  unsigned int m_threads;
+  unsigned int m_maxBandwidth;
+
+  std::vector<Artwork> m_artwork;
+  std::set<CStdString> m_queued;
+  unsigned int m_next;
+  unsigned int m_done;
+  unsigned int m_failed;
+  unsigned int m_skipped;
+  int64_t      m_bytes;
+  unsigned int m_startTime;
+  volatile bool m_cancelled;
+  mutable CCriticalSection m_section;
+};
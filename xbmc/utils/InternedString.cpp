@@ -0,0 +1,193 @@
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "InternedString.h"
+#include "log.h"
+#include "threads/Atomics.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <string.h>
+#include <map>
+
+struct SInternedEntry
+{
+  CStdString    str;
+  volatile long refs;   // every handle using it, only drops to 0 under the pool lock
+};
+
+/*! \brief Process wide set of the strings in use by CInternedString handles.
+
+ An entry is freed as soon as its last handle goes away, so the pool only ever
+ holds strings that are in use. Copying or releasing a handle that isn't the
+ last one is a lock free change of the count, only looking a string up and
+ freeing an entry take the lock.
+ */
+class CInternedPool
+{
+public:
+  CInternedPool() : m_bytes(0) {}
+
+  SInternedEntry *Acquire(const char *str);
+  void AddRef(SInternedEntry *entry);
+  void Release(SInternedEntry *entry);
+  void LogStats();
+
+private:
+  struct less
+  {
+    bool operator()(const char *s1, const char *s2) const
+    {
+      return strcmp(s1, s2) < 0;
+    }
+  };
+  // keyed by the entry's own string, so a lookup doesn't need to copy the string
+  typedef std::map<const char *, SInternedEntry *, less> ENTRIES;
+  ENTRIES          m_entries;
+  unsigned int     m_bytes;
+  CCriticalSection m_critSection;
+};
+
+/* never freed: global items such as the current file release their handles
+   during static destruction, after a static pool would already be gone */
+static CInternedPool &GetPool()
+{
+  static CInternedPool *pool = new CInternedPool;
+  return *pool;
+}
+
+// create the pool during static initialisation, before threads can race for it
+static CInternedPool &g_internedPool = GetPool();
+
+static inline long AddRefs(volatile long *refs, long amount)
+{
+  long old = *refs;
+  while (cas(refs, old, old + amount) != old)
+    old = *refs;
+  return old + amount;
+}
+
+SInternedEntry *CInternedPool::Acquire(const char *str)
+{
+  CSingleLock lock(m_critSection);
+  ENTRIES::iterator it = m_entries.find(str);
+  if (it != m_entries.end())
+  {
+    AddRefs(&it->second->refs, 1);
+    return it->second;
+  }
+
+  SInternedEntry *entry = new SInternedEntry;
+  entry->str  = str;
+  entry->refs = 1;
+  m_entries.insert(std::make_pair(entry->str.c_str(), entry));
+  m_bytes += entry->str.size();
+  return entry;
+}
+
+void CInternedPool::AddRef(SInternedEntry *entry)
+{
+  // the caller holds a handle, so the entry can't be freed meanwhile
+  AddRefs(&entry->refs, 1);
+}
+
+void CInternedPool::Release(SInternedEntry *entry)
+{
+  // other handles keep the entry alive, no need for the lock
+  long refs = entry->refs;
+  while (refs > 1)
+  {
+    long old = cas(&entry->refs, refs, refs - 1);
+    if (old == refs)
+      return;
+    refs = old;
+  }
+
+  // possibly the last handle, Acquire must not find the entry while it's freed
+  CSingleLock lock(m_critSection);
+  if (AddRefs(&entry->refs, -1) == 0)
+  {
+    m_entries.erase(entry->str.c_str());
+    m_bytes -= entry->str.size();
+    delete entry;
+  }
+}
+
+void CInternedPool::LogStats()
+{
+  CSingleLock lock(m_critSection);
+  unsigned int refs = 0;
+  for (ENTRIES::const_iterator it = m_entries.begin(); it != m_entries.end(); ++it)
+    refs += it->second->refs;
+  CLog::Log(LOGDEBUG, "CInternedString: %u strings, %u bytes, %u handles", (unsigned int)m_entries.size(), m_bytes, refs);
+}
+
+CInternedString::CInternedString()
+{
+  m_entry = NULL;
+}
+
+CInternedString::CInternedString(const char *str)
+{
+  m_entry = (str && *str) ? GetPool().Acquire(str) : NULL;
+}
+
+CInternedString::CInternedString(const CStdString &str)
+{
+  m_entry = str.IsEmpty() ? NULL : GetPool().Acquire(str.c_str());
+}
+
+CInternedString::CInternedString(const CInternedString &str)
+{
+  m_entry = str.m_entry;
+  if (m_entry)
+    GetPool().AddRef(m_entry);
+}
+
+CInternedString::~CInternedString()
+{
+  if (m_entry)
+    GetPool().Release(m_entry);
+}
+
+CInternedString &CInternedString::operator=(const CInternedString &str)
+{
+  if (m_entry != str.m_entry)
+  {
+    if (str.m_entry)
+      GetPool().AddRef(str.m_entry);
+    if (m_entry)
+      GetPool().Release(m_entry);
+    m_entry = str.m_entry;
+  }
+  return *this;
+}
+
+const CStdString &CInternedString::Get() const
+{
+  static const CStdString empty;
+  return m_entry ? m_entry->str : empty;
+}
+
+void CInternedString::LogStats()
+{
+  GetPool().LogStats();
+}
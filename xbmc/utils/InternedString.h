@@ -0,0 +1,59 @@
+#pragma once
+/*
+ *      Copyright (C) 2005-2011 Team XBMC
+ *      http://www.xbmc.org
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with XBMC; see the file COPYING.  If not, write to
+ *  the Free Software Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
+ *  http://www.gnu.org/copyleft/gpl.html
+ *
+ */
+
+#include "StdString.h"
+
+struct SInternedEntry;
+
+/*! \brief Reference counted handle to a string that is kept once per process.
+
+ Strings with the same contents share a single copy, so a handle costs one pointer
+ no matter how many items carry the same property name or value. The handles are
+ immutable and may be created, copied and released on any thread.
+ */
+class CInternedString
+{
+public:
+  CInternedString();
+  CInternedString(const char *str);
+  CInternedString(const CStdString &str);
+  CInternedString(const CInternedString &str);
+  ~CInternedString();
+
+  CInternedString &operator=(const CInternedString &str);
+
+  const CStdString &Get() const;
+  const char *c_str() const { return Get().c_str(); };
+  bool IsEmpty() const { return m_entry == NULL; };
+
+  /*! \brief Handles compare equal when they share the same copy, which is whenever their contents are equal.
+   */
+  bool operator==(const CInternedString &str) const { return m_entry == str.m_entry; };
+  bool operator!=(const CInternedString &str) const { return m_entry != str.m_entry; };
+
+  /*! \brief Log the number of strings held, their size and how often they are shared.
+   */
+  static void LogStats();
+
+private:
+  SInternedEntry *m_entry;
+};
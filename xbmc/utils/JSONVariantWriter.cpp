@@ -27,14 +27,7 @@ string CJSONVariantWriter::Write(const CVariant &value, bool compact)
 {
   string output;
 
-#if YAJL_MAJOR == 2
-  yajl_gen g = yajl_gen_alloc(NULL);
-  yajl_gen_config(g, yajl_gen_beautify, compact ? 0 : 1);
-  yajl_gen_config(g, yajl_gen_indent_string, "\t");
-#else
-  yajl_gen_config conf = { compact ? 0 : 1, "\t" };
-  yajl_gen g = yajl_gen_alloc(&conf, NULL);
-#endif
+  yajl_gen g = Allocate(compact);
 
   if (InternalWrite(g, value))
   {
@@ -49,12 +42,63 @@ string CJSONVariantWriter::Write(const CVariant &value, bool compact)
     output = string((const char *)buffer, length);
   }
 
-  yajl_gen_clear(g);
+  yajl_gen_free(g);
 
   return output;
 }
 
-bool CJSONVariantWriter::InternalWrite(yajl_gen g, const CVariant &value)
+bool CJSONVariantWriter::Write(const CVariant &value, IJSONWriteCallback *callback, bool compact, unsigned int chunkSize /* = 16384 */)
+{
+  if (callback == NULL)
+    return false;
+
+  yajl_gen g = Allocate(compact);
+
+  bool success = InternalWrite(g, value, callback, chunkSize);
+  if (success)
+    success = Flush(g, callback);
+
+  yajl_gen_free(g);
+
+  return success;
+}
+
+yajl_gen CJSONVariantWriter::Allocate(bool compact)
+{
+#if YAJL_MAJOR == 2
+  yajl_gen g = yajl_gen_alloc(NULL);
+  yajl_gen_config(g, yajl_gen_beautify, compact ? 0 : 1);
+  yajl_gen_config(g, yajl_gen_indent_string, "\t");
+#else
+  yajl_gen_config conf = { compact ? 0 : 1, "\t" };
+  yajl_gen g = yajl_gen_alloc(&conf, NULL);
+#endif
+
+  return g;
+}
+
+bool CJSONVariantWriter::Flush(yajl_gen g, IJSONWriteCallback *callback, unsigned int minimumSize /* = 0 */)
+{
+  const unsigned char * buffer;
+#if YAJL_MAJOR == 2
+  size_t length;
+#else
+  unsigned int length;
+#endif
+
+  yajl_gen_get_buf(g, &buffer, &length);
+  if (length == 0 || length < minimumSize)
+    return true;
+
+  bool success = callback->OnWrite((const char *)buffer, (unsigned int)length);
+
+  // only resets the output buffer, the generator state is kept
+  yajl_gen_clear(g);
+
+  return success;
+}
+
+bool CJSONVariantWriter::InternalWrite(yajl_gen g, const CVariant &value, IJSONWriteCallback *callback /* = NULL */, unsigned int chunkSize /* = 0 */)
 {
   bool success = false;
 
@@ -91,7 +135,11 @@ bool CJSONVariantWriter::InternalWrite(yajl_gen g, const CVariant &value)
     success = yajl_gen_status_ok == yajl_gen_array_open(g);
 
     for (CVariant::const_iterator_array itr = value.begin_array(); itr != value.end_array() && success; itr++)
-      success &= InternalWrite(g, *itr);
+    {
+      success &= InternalWrite(g, *itr, callback, chunkSize);
+      if (success && callback != NULL)
+        success = Flush(g, callback, chunkSize);
+    }
 
     if (success)
       success = yajl_gen_status_ok == yajl_gen_array_close(g);
@@ -108,7 +156,9 @@ bool CJSONVariantWriter::InternalWrite(yajl_gen g, const CVariant &value)
       success &= yajl_gen_status_ok == yajl_gen_string(g, (const unsigned char*)itr->first.c_str(), itr->first.length());
 #endif
       if (success)
-        success &= InternalWrite(g, itr->second);
+        success &= InternalWrite(g, itr->second, callback, chunkSize);
+      if (success && callback != NULL)
+        success = Flush(g, callback, chunkSize);
     }
 
     if (success)
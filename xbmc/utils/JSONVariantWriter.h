@@ -27,10 +27,40 @@
 #include <yajl/yajl_version.h>
 #endif
 
+class IJSONWriteCallback
+{
+public:
+  virtual ~IJSONWriteCallback() { }
+
+  /*!
+   \brief Receives the next chunk of serialized JSON output
+   \param data Serialized output (not null-terminated)
+   \param length Length of data in bytes
+   \return false to abort the serialization
+   */
+  virtual bool OnWrite(const char *data, unsigned int length) = 0;
+};
+
 class CJSONVariantWriter
 {
 public:
   static std::string Write(const CVariant &value, bool compact);
+
+  /*!
+   \brief Serializes the given value in chunks instead of one string
+   \param value Value to serialize
+   \param callback Receiver of the serialized chunks
+   \param compact Whether to produce compact or beautified output
+   \param chunkSize Size in bytes after which output is handed to the callback
+   \return true if the whole value was serialized and accepted by the callback
+
+   Output is flushed to the callback whenever the generator buffer exceeds
+   chunkSize, so the serialized form of large values never has to be held
+   in memory as a whole.
+   */
+  static bool Write(const CVariant &value, IJSONWriteCallback *callback, bool compact, unsigned int chunkSize = 16384);
 private:
-  static bool InternalWrite(yajl_gen g, const CVariant &value);
+  static bool InternalWrite(yajl_gen g, const CVariant &value, IJSONWriteCallback *callback = NULL, unsigned int chunkSize = 0);
+  static bool Flush(yajl_gen g, IJSONWriteCallback *callback, unsigned int minimumSize = 0);
+  static yajl_gen Allocate(bool compact);
 };
@@ -122,6 +122,15 @@ void CJobQueue::QueueNextJob()
   }
 }
 
+void CJobQueue::TakeQueuedJobs(std::vector<CJob *> &jobs)
+{
+  CSingleLock lock(m_section);
+  // jobs are started from the back of the queue
+  for (Queue::reverse_iterator i = m_jobQueue.rbegin(); i != m_jobQueue.rend(); ++i)
+    jobs.push_back(i->m_job);
+  m_jobQueue.clear();
+}
+
 void CJobQueue::CancelJobs()
 {
   CSingleLock lock(m_section);
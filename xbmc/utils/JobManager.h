@@ -126,6 +126,15 @@ public:
    */
   virtual void OnJobComplete(unsigned int jobID, bool success, CJob *job);
 
+protected:
+  /*!
+   \brief Take the jobs that have not been started yet out of the queue
+   The caller then owns the jobs, and may hand them back later with AddJob to reorder them.
+   \param jobs [out] the jobs, in the order they would have been started.
+   \sa AddJob
+   */
+  void TakeQueuedJobs(std::vector<CJob *> &jobs);
+
 private:
   void QueueNextJob();
 
@@ -69,3 +69,13 @@ void CPCMAmplifier::DeAmplify(short *pcm, int nSamples)
     pcm[nSample] = (short)nSampleValue;
   }
 }
+
+void CPCMAmplifier::DeAmplify(float *pcm, int nSamples)
+{
+  if (m_dFactor >= 1.0)
+    return;
+
+  float factor = (float)m_dFactor;
+  for (int nSample=0; nSample<nSamples; nSample++)
+    pcm[nSample] *= factor;
+}
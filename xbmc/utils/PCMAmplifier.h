@@ -32,6 +32,8 @@ public:
 
   // only works on 16bit samples
   void DeAmplify(short *pcm, int nSamples);
+  // and the same for float samples
+  void DeAmplify(float *pcm, int nSamples);
 
 protected:
   int m_nVolume;
@@ -24,9 +24,262 @@
 #include "RegExp.h"
 #include "StdString.h"
 #include "log.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include <map>
+#include <vector>
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#include <pthread.h>
+#endif
 
 using namespace PCRE;
 
+// beyond this many patterns the least recently used unreferenced one is dropped for each new one
+#define REGEXP_CACHE_SIZE 500
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+// pcre's default JIT stack is 32K, too small for backtracking over large scraper pages
+#define REGEXP_JIT_STACK_START (32 * 1024)
+#define REGEXP_JIT_STACK_MAX   (1024 * 1024)
+#endif
+
+struct SRegExpCompiled
+{
+  pcre        *re;
+  pcre_extra  *extra;
+  long         refs;    // the cache and every CRegExp using it, changed under the cache lock
+  unsigned int lastUse; // cache clock of the last Acquire, for evicting
+};
+
+/*! \brief Process wide cache of compiled and studied patterns.
+
+ Scrapers and the scanners compile the same few expressions for every file. A
+ compiled pattern is never modified by pcre_exec, so one copy can be used by any
+ number of CRegExp objects on any thread.
+ */
+class CRegExpCache
+{
+public:
+  CRegExpCache() : m_clock(0), m_hits(0), m_misses(0), m_evictions(0) {}
+
+  SRegExpCompiled *Acquire(const char *pattern, int options);
+  void AddRef(SRegExpCompiled *compiled);
+  void Release(SRegExpCompiled *compiled);
+  void LogStats();
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+  /*! \brief Lend a JIT stack to the calling thread for one pcre_exec.
+   A JIT stack can't be used by two threads at once, so the stacks are pooled
+   rather than kept per thread, which would leak them as job threads come and go.
+   */
+  pcre_jit_stack *AcquireJitStack();
+  void ReleaseJitStack(pcre_jit_stack *stack);
+#endif
+
+private:
+  void Evict();
+  static void Free(SRegExpCompiled *compiled);
+
+  typedef std::map<std::pair<std::string, int>, SRegExpCompiled*> CacheMap;
+  CCriticalSection m_section;
+  CacheMap         m_cache;
+  unsigned int     m_clock;
+  unsigned int     m_hits;
+  unsigned int     m_misses;
+  unsigned int     m_evictions;
+#ifdef PCRE_STUDY_JIT_COMPILE
+  std::vector<pcre_jit_stack *> m_jitStacks;
+#endif
+};
+
+/* never freed: global and static CRegExp objects release their patterns during
+   static destruction, after a static cache would already be gone */
+static CRegExpCache &GetCache()
+{
+  static CRegExpCache *cache = new CRegExpCache;
+  return *cache;
+}
+
+// create the cache during static initialisation, before threads can race for it
+static CRegExpCache &g_regExpCache = GetCache();
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+// the stack RegFind lent to the current thread, handed to pcre by JitStackCallback
+#if defined(__APPLE__) || defined(__FreeBSD__)
+static pthread_once_t g_jitStackOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t  g_jitStackKey;
+
+static void MakeJitStackKey()
+{
+  pthread_key_create(&g_jitStackKey, NULL);
+}
+
+static void SetThreadJitStack(pcre_jit_stack *stack)
+{
+  pthread_once(&g_jitStackOnce, MakeJitStackKey);
+  pthread_setspecific(g_jitStackKey, stack);
+}
+
+static pcre_jit_stack *JitStackCallback(void *)
+{
+  return (pcre_jit_stack *)pthread_getspecific(g_jitStackKey);
+}
+#else
+#ifdef _MSC_VER
+static __declspec(thread) pcre_jit_stack *t_jitStack = NULL;
+#else
+static __thread pcre_jit_stack *t_jitStack = NULL;
+#endif
+
+static void SetThreadJitStack(pcre_jit_stack *stack)
+{
+  t_jitStack = stack;
+}
+
+static pcre_jit_stack *JitStackCallback(void *)
+{
+  return t_jitStack;
+}
+#endif
+#endif
+
+SRegExpCompiled *CRegExpCache::Acquire(const char *pattern, int options)
+{
+  std::pair<std::string, int> key(pattern, options);
+  {
+    CSingleLock lock(m_section);
+    CacheMap::iterator it = m_cache.find(key);
+    if (it != m_cache.end())
+    {
+      m_hits++;
+      it->second->refs++;
+      it->second->lastUse = ++m_clock;
+      return it->second;
+    }
+  }
+
+  // compile outside the lock, other threads may still use the cache meanwhile
+  const char *errMsg = NULL;
+  int errOffset      = 0;
+  pcre *re = pcre_compile(pattern, options, &errMsg, &errOffset, NULL);
+  if (!re)
+  {
+    CLog::Log(LOGERROR, "PCRE: %s. Compilation failed at offset %d in expression '%s'",
+              errMsg, errOffset, pattern);
+    return NULL;
+  }
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+  pcre_extra *extra = pcre_study(re, PCRE_STUDY_JIT_COMPILE, &errMsg);
+  if (extra && (extra->flags & PCRE_EXTRA_EXECUTABLE_JIT))
+    pcre_assign_jit_stack(extra, JitStackCallback, NULL);
+#else
+  pcre_extra *extra = pcre_study(re, 0, &errMsg);
+#endif
+
+  SRegExpCompiled *compiled = new SRegExpCompiled;
+  compiled->re    = re;
+  compiled->extra = extra;
+  compiled->refs  = 2; // the cache and the caller
+
+  CSingleLock lock(m_section);
+  CacheMap::iterator it = m_cache.find(key);
+  if (it != m_cache.end())
+  { // someone else was quicker
+    Free(compiled);
+    m_hits++;
+    it->second->refs++;
+    it->second->lastUse = ++m_clock;
+    return it->second;
+  }
+
+  if (m_cache.size() >= REGEXP_CACHE_SIZE)
+    Evict();
+
+  m_misses++;
+  compiled->lastUse = ++m_clock;
+  m_cache.insert(std::make_pair(key, compiled));
+  return compiled;
+}
+
+void CRegExpCache::Evict()
+{
+  // only the cache holds these, patterns in use stay however old they are
+  CacheMap::iterator oldest = m_cache.end();
+  for (CacheMap::iterator it = m_cache.begin(); it != m_cache.end(); ++it)
+  {
+    if (it->second->refs == 1 && (oldest == m_cache.end() || m_clock - it->second->lastUse > m_clock - oldest->second->lastUse))
+      oldest = it;
+  }
+
+  if (oldest == m_cache.end())
+    return;
+
+  Free(oldest->second);
+  m_cache.erase(oldest);
+  m_evictions++;
+}
+
+void CRegExpCache::AddRef(SRegExpCompiled *compiled)
+{
+  CSingleLock lock(m_section);
+  compiled->refs++;
+}
+
+void CRegExpCache::Release(SRegExpCompiled *compiled)
+{
+  CSingleLock lock(m_section);
+  if (--compiled->refs == 0)
+    Free(compiled);
+}
+
+void CRegExpCache::Free(SRegExpCompiled *compiled)
+{
+  if (compiled->extra)
+  {
+#ifdef PCRE_STUDY_JIT_COMPILE
+    pcre_free_study(compiled->extra);
+#else
+    pcre_free(compiled->extra);
+#endif
+  }
+  pcre_free(compiled->re);
+  delete compiled;
+}
+
+#ifdef PCRE_STUDY_JIT_COMPILE
+pcre_jit_stack *CRegExpCache::AcquireJitStack()
+{
+  {
+    CSingleLock lock(m_section);
+    if (!m_jitStacks.empty())
+    {
+      pcre_jit_stack *stack = m_jitStacks.back();
+      m_jitStacks.pop_back();
+      return stack;
+    }
+  }
+  // the maximum is only reserved, memory is committed as the stack grows
+  return pcre_jit_stack_alloc(REGEXP_JIT_STACK_START, REGEXP_JIT_STACK_MAX);
+}
+
+void CRegExpCache::ReleaseJitStack(pcre_jit_stack *stack)
+{
+  if (!stack)
+    return;
+  CSingleLock lock(m_section);
+  m_jitStacks.push_back(stack);
+}
+#endif
+
+void CRegExpCache::LogStats()
+{
+  CSingleLock lock(m_section);
+  unsigned int total = m_hits + m_misses;
+  CLog::Log(LOGDEBUG, "PCRE: %u patterns cached, %u of %u compilations avoided (%.1f%%), %u evicted",
+            (unsigned int)m_cache.size(), m_hits, total, total ? 100.0 * m_hits / total : 0.0, m_evictions);
+}
+
 CRegExp::CRegExp(bool caseless)
 {
   m_re          = NULL;
@@ -47,23 +300,19 @@ CRegExp::CRegExp(const CRegExp& re)
 
 const CRegExp& CRegExp::operator=(const CRegExp& re)
 {
-  size_t size;
+  if (&re == this)
+    return *this;
   Cleanup();
   m_pattern = re.m_pattern;
   if (re.m_re)
   {
-    if (pcre_fullinfo(re.m_re, NULL, PCRE_INFO_SIZE, &size) >= 0)
-    {
-      if ((m_re = (pcre*)malloc(size)))
-      {
-        memcpy(m_re, re.m_re, size);
-        memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
-        m_iMatchCount = re.m_iMatchCount;
-        m_bMatched = re.m_bMatched;
-        m_subject = re.m_subject;
-        m_iOptions = re.m_iOptions;
-      }
-    }
+    m_re = re.m_re;
+    GetCache().AddRef(m_re);
+    memcpy(m_iOvector, re.m_iOvector, OVECCOUNT*sizeof(int));
+    m_iMatchCount = re.m_iMatchCount;
+    m_bMatched = re.m_bMatched;
+    m_subject = re.m_subject;
+    m_iOptions = re.m_iOptions;
   }
   return *this;
 }
@@ -73,6 +322,15 @@ CRegExp::~CRegExp()
   Cleanup();
 }
 
+void CRegExp::Cleanup()
+{
+  if (m_re)
+  {
+    GetCache().Release(m_re);
+    m_re = NULL;
+  }
+}
+
 CRegExp* CRegExp::RegComp(const char *re)
 {
   if (!re)
@@ -80,17 +338,13 @@ CRegExp* CRegExp::RegComp(const char *re)
 
   m_bMatched         = false;
   m_iMatchCount      = 0;
-  const char *errMsg = NULL;
-  int errOffset      = 0;
 
   Cleanup();
 
-  m_re = pcre_compile(re, m_iOptions, &errMsg, &errOffset, NULL);
+  m_re = GetCache().Acquire(re, m_iOptions);
   if (!m_re)
   {
     m_pattern.clear();
-    CLog::Log(LOGERROR, "PCRE: %s. Compilation failed at offset %d in expression '%s'",
-              errMsg, errOffset, re);
     return NULL;
   }
 
@@ -117,7 +371,30 @@ int CRegExp::RegFind(const char* str, int startoffset)
   }
 
   m_subject = str;
-  int rc = pcre_exec(m_re, NULL, str, strlen(str), startoffset, 0, m_iOvector, OVECCOUNT);
+  int length = strlen(str);
+#ifdef PCRE_STUDY_JIT_COMPILE
+  int rc;
+  if (m_re->extra && (m_re->extra->flags & PCRE_EXTRA_EXECUTABLE_JIT))
+  {
+    pcre_jit_stack *stack = GetCache().AcquireJitStack();
+    SetThreadJitStack(stack);
+    rc = pcre_exec(m_re->re, m_re->extra, str, length, startoffset, 0, m_iOvector, OVECCOUNT);
+    SetThreadJitStack(NULL);
+    GetCache().ReleaseJitStack(stack);
+
+    if (rc == PCRE_ERROR_JIT_STACKLIMIT)
+    { // the interpreter backtracks on the heap and machine stack, so it still matches
+      CLog::Log(LOGDEBUG, "PCRE: JIT stack exhausted, matching '%s' without JIT", m_pattern.c_str());
+      pcre_extra extra = *m_re->extra;
+      extra.flags &= ~PCRE_EXTRA_EXECUTABLE_JIT;
+      rc = pcre_exec(m_re->re, &extra, str, length, startoffset, 0, m_iOvector, OVECCOUNT);
+    }
+  }
+  else
+    rc = pcre_exec(m_re->re, m_re->extra, str, length, startoffset, 0, m_iOvector, OVECCOUNT);
+#else
+  int rc = pcre_exec(m_re->re, m_re->extra, str, length, startoffset, 0, m_iOvector, OVECCOUNT);
+#endif
 
   if (rc<1)
   {
@@ -144,7 +421,7 @@ int CRegExp::GetCaptureTotal()
 {
   int c = -1;
   if (m_re)
-    pcre_fullinfo(m_re, NULL, PCRE_INFO_CAPTURECOUNT, &c);
+    pcre_fullinfo(m_re->re, m_re->extra, PCRE_INFO_CAPTURECOUNT, &c);
   return c;
 }
 
@@ -239,7 +516,9 @@ std::string CRegExp::GetMatch(int iSub /* = 0 */)
 bool CRegExp::GetNamedSubPattern(const char* strName, std::string& strMatch)
 {
   strMatch.clear();
-  int iSub = pcre_get_stringnumber(m_re, strName);
+  if (!m_re)
+    return false;
+  int iSub = pcre_get_stringnumber(m_re->re, strName);
   if (iSub < 0)
     return false;
   strMatch = GetMatch(iSub);
@@ -264,3 +543,8 @@ void CRegExp::DumpOvector(int iLog /* = LOGDEBUG */)
   str += "}";
   CLog::Log(iLog, "regexp ovector=%s", str.c_str());
 }
+
+void CRegExp::LogCacheStats()
+{
+  GetCache().LogStats();
+}
@@ -39,6 +39,8 @@ namespace PCRE {
 // OVEVCOUNT must be a multiple of 3
 const int OVECCOUNT=(20+1)*3;
 
+struct SRegExpCompiled;
+
 class CRegExp
 {
 public:
@@ -68,11 +70,16 @@ public:
   void DumpOvector(int iLog);
   const CRegExp& operator= (const CRegExp& re);
 
+  /*! \brief Log how often RegComp found its pattern already compiled.
+   Compiled patterns are shared process wide, keyed by pattern and options.
+   */
+  static void LogCacheStats();
+
 private:
-  void Cleanup() { if (m_re) { PCRE::pcre_free(m_re); m_re = NULL; } }
+  void Cleanup();
 
 private:
-  PCRE::pcre* m_re;
+  SRegExpCompiled* m_re;
   int         m_iOvector[OVECCOUNT];
   int         m_iMatchCount;
   int         m_iOptions;
@@ -200,6 +200,69 @@ int64_t StringUtils::AlphaNumericCompare(const wchar_t *left, const wchar_t *rig
   return 0; // files are the same
 }
 
+// append value + 1 in the utf8 scheme extended to 31 bits, so bytewise order
+// follows the values and a 0 byte sorts before everything
+static void AppendSortKeyValue(std::string &key, uint32_t value)
+{
+  uint32_t c = value + 1;
+  if (c < 0x80)
+  {
+    key += (char)c;
+    return;
+  }
+
+  int bytes = c < 0x800 ? 2 : c < 0x10000 ? 3 : c < 0x200000 ? 4 : c < 0x4000000 ? 5 : 6;
+  static const unsigned char lead[7] = { 0, 0, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
+  key += (char)(lead[bytes] | (c >> (6 * (bytes - 1))));
+  for (int i = bytes - 2; i >= 0; i--)
+    key += (char)(0x80 | ((c >> (6 * i)) & 0x3F));
+}
+
+// the collation of a single character, terminated so that no character's
+// key is a prefix of another's
+static void AppendSortKeyChar(std::string &key, const collate<wchar_t> &coll, wchar_t c, bool terminate)
+{
+  std::wstring weights = coll.transform(&c, &c + 1);
+  for (size_t i = 0; i < weights.size(); i++)
+    AppendSortKeyValue(key, (uint32_t)weights[i]);
+  if (terminate)
+    key += '\0';
+}
+
+void StringUtils::AlphaNumericSortKey(const wchar_t *label, std::string &key)
+{
+  key.clear();
+  const collate<wchar_t>& coll = use_facet< collate<wchar_t> >( locale() );
+  const wchar_t *l = label;
+  while (*l != 0)
+  {
+    if (*l >= L'0' && *l <= L'9')
+    { // runs of up to 15 digits, as AlphaNumericCompare reads them.
+      // against other characters a number collates as '0' (digits are next to
+      // each other in every collation), then a byte below any weight marks it
+      // as a number, followed by the length and the digits of the value so
+      // longer numbers sort after shorter ones
+      const wchar_t *end = l;
+      while (*end >= L'0' && *end <= L'9' && end < l + 15)
+        end++;
+      while (l < end && *l == L'0')
+        l++;
+      AppendSortKeyChar(key, coll, L'0', false);
+      key += '\0';
+      key += (char)(end - l + 1);
+      for (; l < end; l++)
+        key += (char)*l;
+      continue;
+    }
+
+    // the rest is compared with the collation of the current language
+    wchar_t c = *l++;
+    if (c >= L'A' && c <= L'Z')
+      c += L'a' - L'A';
+    AppendSortKeyChar(key, coll, c, true);
+  }
+}
+
 int StringUtils::DateStringToYYYYMMDD(const CStdString &dateString)
 {
   CStdStringArray days;
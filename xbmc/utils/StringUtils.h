@@ -44,6 +44,13 @@ public:
   static int SplitString(const CStdString& input, const CStdString& delimiter, CStdStringArray &results, unsigned int iMaxStrings = 0);
   static int FindNumber(const CStdString& strInput, const CStdString &strFind);
   static int64_t AlphaNumericCompare(const wchar_t *left, const wchar_t *right);
+  /*! \brief Build a key for label that compares bytewise (memcmp) the way AlphaNumericCompare compares labels.
+   Digit runs are stored by value so "2" sorts before "10", ascii letters are folded to lower case and
+   the other characters are stored as their weights in the collation of the current locale.
+   \param label the label to build the key for
+   \param key [out] the key
+   */
+  static void AlphaNumericSortKey(const wchar_t *label, std::string &key);
   static long TimeStringToSeconds(const CStdString &timeString);
   static void RemoveCRLF(CStdString& strLine);
 
@@ -20,6 +20,7 @@
  */
 #include "Variant.h"
 #include <string.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -41,7 +42,7 @@ CVariant::CVariant(VariantType type)
       m_data.boolean = false;
       break;
     case VariantTypeString:
-      m_data.string = NULL;
+      m_data.string = new string();
       break;
     case VariantTypeDouble:
       m_data.dvalue = 0.0;
@@ -121,10 +122,42 @@ CVariant::CVariant(const string &str)
 CVariant::CVariant(const CVariant &variant)
 {
   m_type = variant.m_type;
-  *this = variant;
+
+  switch (m_type)
+  {
+  case VariantTypeInteger:
+    m_data.integer = variant.m_data.integer;
+    break;
+  case VariantTypeUnsignedInteger:
+    m_data.unsignedinteger = variant.m_data.unsignedinteger;
+    break;
+  case VariantTypeBoolean:
+    m_data.boolean = variant.m_data.boolean;
+    break;
+  case VariantTypeDouble:
+    m_data.dvalue = variant.m_data.dvalue;
+    break;
+  case VariantTypeString:
+    m_data.string = new string(*variant.m_data.string);
+    break;
+  case VariantTypeArray:
+    m_data.array = new VariantArray(*variant.m_data.array);
+    break;
+  case VariantTypeObject:
+    m_data.map = new VariantMap(*variant.m_data.map);
+    break;
+  default:
+    memset(&m_data, 0, sizeof(m_data));
+    break;
+  }
 }
 
 CVariant::~CVariant()
+{
+  cleanup();
+}
+
+void CVariant::cleanup()
 {
   if (m_type == VariantTypeString && m_data.string)
   {
@@ -236,7 +269,7 @@ const char *CVariant::asString(const char *fallback) const
     return fallback;
 }
 
-CVariant &CVariant::operator[](string key)
+CVariant &CVariant::operator[](const string &key)
 {
   if (m_type == VariantTypeNull)
   {
@@ -250,12 +283,16 @@ CVariant &CVariant::operator[](string key)
     return ConstNullVariant;
 }
 
-const CVariant &CVariant::operator[](std::string key) const
+const CVariant &CVariant::operator[](const string &key) const
 {
   if (m_type == VariantTypeObject)
-    return (*m_data.map)[key];
-  else
-    return ConstNullVariant;
+  {
+    VariantMap::const_iterator it = m_data.map->find(key);
+    if (it != m_data.map->end())
+      return it->second;
+  }
+
+  return ConstNullVariant;
 }
 
 CVariant &CVariant::operator[](unsigned int position)
@@ -276,43 +313,22 @@ const CVariant &CVariant::operator[](unsigned int position) const
 
 CVariant &CVariant::operator=(const CVariant &rhs)
 {
-  if (m_type == VariantTypeConstNull)
+  if (m_type == VariantTypeConstNull || this == &rhs)
     return *this;
 
-  m_type = rhs.m_type;
-
-  switch (m_type)
-  {
-  case VariantTypeInteger:
-    m_data.integer = rhs.m_data.integer;
-    break;
-  case VariantTypeUnsignedInteger:
-    m_data.integer = rhs.m_data.unsignedinteger;
-    break;
-  case VariantTypeBoolean:
-    m_data.boolean = rhs.m_data.boolean;
-    break;
-  case VariantTypeDouble:
-    m_data.dvalue = rhs.m_data.dvalue;
-    break;
-  case VariantTypeString:
-    m_data.string = new string(rhs.m_data.string->c_str());
-    break;
-  case VariantTypeArray:
-    m_data.array = new VariantArray(rhs.m_data.array->begin(), rhs.m_data.array->end());
-    break;
-  case VariantTypeObject:
-    m_data.map = new VariantMap(rhs.m_data.map->begin(), rhs.m_data.map->end());
-    break;
-  default:
-    break;
-  }
+  // copy first so that rhs may be a child of this variant
+  CVariant copy(rhs);
+  swap(copy);
 
   return *this;
 }
 
 bool CVariant::operator==(const CVariant &rhs) const
 {
+  // a null is a null, whether it is the shared constant or not
+  if (isNull() || rhs.isNull())
+    return isNull() && rhs.isNull();
+
   if (m_type == rhs.m_type)
   {
     switch (m_type)
@@ -346,7 +362,7 @@ bool CVariant::operator==(const CVariant &rhs) const
   return false;
 }
 
-void CVariant::push_back(CVariant variant)
+void CVariant::push_back(const CVariant &variant)
 {
   if (m_type == VariantTypeNull)
   {
@@ -355,14 +371,54 @@ void CVariant::push_back(CVariant variant)
   }
 
   if (m_type == VariantTypeArray)
-    m_data.array->push_back(variant);
+  {
+    // variant may be an element of this array so copy it before growing
+    CVariant copy(variant);
+    swap_back(copy);
+  }
 }
 
-void CVariant::append(CVariant variant)
+void CVariant::append(const CVariant &variant)
 {
   push_back(variant);
 }
 
+void CVariant::swap_back(CVariant &variant)
+{
+  if (variant.m_type == VariantTypeConstNull)
+    return;
+
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeArray;
+    m_data.array = new VariantArray();
+  }
+
+  if (m_type == VariantTypeArray)
+  {
+    reserve_array(m_data.array->size() + 1);
+    m_data.array->push_back(CVariant());
+    m_data.array->back().swap(variant);
+  }
+}
+
+void CVariant::reserve_array(unsigned int size)
+{
+  if (size <= m_data.array->capacity())
+    return;
+
+  // grow by swapping the elements into the new storage, std::vector would
+  // deep copy every element (and all its children) instead
+  VariantArray *array = new VariantArray();
+  array->reserve(max((size_t)size, max((size_t)4, m_data.array->capacity() * 2)));
+  array->resize(m_data.array->size());
+  for (unsigned int i = 0; i < m_data.array->size(); i++)
+    (*array)[i].swap((*m_data.array)[i]);
+
+  delete m_data.array;
+  m_data.array = array;
+}
+
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
@@ -373,6 +429,10 @@ const char *CVariant::c_str() const
 
 void CVariant::swap(CVariant &rhs)
 {
+  // like operator=, never write to the shared ConstNullVariant
+  if (m_type == VariantTypeConstNull || rhs.m_type == VariantTypeConstNull)
+    return;
+
   VariantType  temp_type = m_type;
   VariantUnion temp_data = m_data;
 
@@ -477,7 +537,7 @@ void CVariant::clear()
     m_data.array->clear();
 }
 
-void CVariant::erase(std::string key)
+void CVariant::erase(const string &key)
 {
   if (m_type == VariantTypeNull)
   {
@@ -500,7 +560,7 @@ void CVariant::erase(unsigned int position)
     m_data.array->erase(m_data.array->begin() + position);
 }
 
-bool CVariant::isMember(string key) const
+bool CVariant::isMember(const string &key) const
 {
   if (m_type == VariantTypeObject)
     return m_data.map->find(key) != m_data.map->end();
@@ -73,19 +73,29 @@ public:
   double asDouble(double fallback = 0.0) const;
   float asFloat(float fallback = 0.0f) const;
 
-  CVariant &operator[](std::string key);
-  const CVariant &operator[](std::string key) const;
+  CVariant &operator[](const std::string &key);
+  const CVariant &operator[](const std::string &key) const;
   CVariant &operator[](unsigned int position);
   const CVariant &operator[](unsigned int position) const;
 
   CVariant &operator=(const CVariant &rhs);
   bool operator==(const CVariant &rhs) const;
 
-  void push_back(CVariant variant);
-  void append(CVariant variant);
+  void push_back(const CVariant &variant);
+  void append(const CVariant &variant);
+  /*!
+   \brief Appends the given variant to this array by swapping, leaving
+   variant null. Avoids the deep copy of push_back() for large values.
+   Does nothing if either side is the ConstNullVariant.
+   */
+  void swap_back(CVariant &variant);
 
   const char *c_str() const;
 
+  /*!
+   \brief Exchanges the values of two variants, does nothing if either one
+   is the ConstNullVariant.
+   */
   void swap(CVariant &rhs);
 
 private:
@@ -112,12 +122,15 @@ public:
   unsigned int size() const;
   bool empty() const;
   void clear();
-  void erase(std::string key);
+  void erase(const std::string &key);
   void erase(unsigned int position);
 
-  bool isMember(std::string key) const;
+  bool isMember(const std::string &key) const;
 
 private:
+  void cleanup();
+  void reserve_array(unsigned int size);
+
   union VariantUnion
   {
     int64_t integer;
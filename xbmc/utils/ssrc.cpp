@@ -2529,6 +2529,7 @@ Cssrc::Cssrc(void)
   stage2DS = NULL;
   UpSampling = false;
   DownSampling = false;
+  m_bFloatOutput = false;
 }
 
 //--------------------------------------------------------------------------------------
@@ -3182,8 +3183,12 @@ bool Cssrc::InitFilters(void)
 //---------------------------------------------------------------------------
 // Inits Freq Converter, returns false if cannot do
 //---------------------------------------------------------------------------
-bool Cssrc::InitConverter(int OldFreq, int OldBPS, int Channels, int NewFreq, int NewBPS, int OutputBufferSize)
+bool Cssrc::InitConverter(int OldFreq, int OldBPS, int Channels, int NewFreq, int NewBPS, int OutputBufferSize, bool FloatOutput)
 {
+  if (FloatOutput && NewBPS != 32)
+    return (false);
+  m_bFloatOutput = FloatOutput;
+
   // The amount of data taken from the output buffer at a time
   m_iOutputBufferSize = OutputBufferSize;
 
@@ -3383,7 +3388,26 @@ int Cssrc::UpSampleCommon(unsigned char * *pRetDataPtr, bool IsEof, int toberead
   }
   rp += nsmplwrt1 * (sfrq / frqgcd) / osf;
 
-  switch (dbps)
+  if (m_bFloatOutput)
+  {
+    REAL gain2 = REAL(gain);
+    for (i = 0;i < nsmplwrt2*nch;i++)
+    {
+      REAL s = outbuf[i] * gain2;
+      if (s < -1)
+      {
+        peak = peak < -s ? -s : peak;
+        s = -1;
+      }
+      if (1 < s)
+      {
+        peak = peak < s ? s : peak;
+        s = 1;
+      }
+      ((float *)rawoutbuf)[i] = (float)s;
+    }
+  }
+  else switch (dbps)
   {
   case 1:
     {
@@ -3712,7 +3736,26 @@ int Cssrc::DownSampleCommon(unsigned char * *pRetDataPtr, bool IsEof, int tobere
 
   rp2 += nsmplwrt2 * (fs2 / dfrq);
 
-  switch (dbps)
+  if (m_bFloatOutput)
+  {
+    REAL gain2 = REAL(gain);
+    for (i = 0;i < nsmplwrt2*nch;i++)
+    {
+      REAL s = outbuf[i] * gain2;
+      if (s < -1)
+      {
+        peak = peak < -s ? -s : peak;
+        s = -1;
+      }
+      if (1 < s)
+      {
+        peak = peak < s ? s : peak;
+        s = 1;
+      }
+      ((float *)rawoutbuf)[i] = (float)s;
+    }
+  }
+  else switch (dbps)
   {
   case 1:
     {
@@ -4137,7 +4180,16 @@ int Cssrc::PutFloatData(float *pInData, int numSamples)
   }
   else
   { // just convert to the output bits per sample
-    if (dbps == 2)  // 16 bit
+    if (m_bFloatOutput)
+    { // no conversion needed, just make sure we're in range
+      float *pOutput = (float *)(m_pResampleBuffer + m_iResampleBufferPos);
+      float *pInput = (float *)pInData;
+      for (int i = 0; i < numSamples; i++)
+        *(pOutput++) = std::max(std::min(*(pInput++), 1.0f), -1.0f);
+
+      m_iResampleBufferPos += numSamples * dbps;
+    }
+    else if (dbps == 2)  // 16 bit
     { // most likely for us - convert float -> short with rounding
       short *pShort = (short *)m_pResampleBuffer;
       float *pInput = (float *)pInData;
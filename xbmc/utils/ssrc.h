@@ -112,8 +112,9 @@ public:
 
   //---------------------------------------------------------------------------
   // Inits Freq Converter, returns false if cannot do
+  // FloatOutput gives native float samples (NewBPS must be 32) instead of PCM
   //---------------------------------------------------------------------------
-  bool InitConverter(int OldFreq, int OldBPS, int Channels, int NewFreq, int NewBPS, int OutputBufferSize);
+  bool InitConverter(int OldFreq, int OldBPS, int Channels, int NewFreq, int NewBPS, int OutputBufferSize, bool FloatOutput = false);
 
   //---------------------------------------------------------------------------
   // returns the input bitrate that we are using (in bits per second)
@@ -182,6 +183,7 @@ private:
   int *randbuf, randptr;
   bool UpSampling;
   bool DownSampling;
+  bool m_bFloatOutput;
   int frqgcd, nch, sfrq, bps, dfrq, dbps, osf, fs1, fs2;
   int n1, n1x, n1y, n2, n2b, n2x, n2y, n1b;
   int filter2len; /* stage 2 filter length */
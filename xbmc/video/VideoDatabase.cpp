@@ -2740,6 +2740,55 @@ CVideoInfoTag CVideoDatabase::GetDetailsByTypeAndId(VIDEODB_CONTENT_TYPE type, i
   return details;
 }
 
+// add the stream in the current row of a streamdetails query, returns false for unknown stream types
+static bool AddStreamDetail(dbiplus::Dataset *pDS, CStreamDetails &details)
+{
+  CStreamDetail::StreamType e = (CStreamDetail::StreamType)pDS->fv(1).get_asInt();
+  switch (e)
+  {
+  case CStreamDetail::VIDEO:
+    {
+      CStreamDetailVideo *p = new CStreamDetailVideo();
+      p->m_strCodec = pDS->fv(2).get_asString();
+      p->m_fAspect = pDS->fv(3).get_asFloat();
+      p->m_iWidth = pDS->fv(4).get_asInt();
+      p->m_iHeight = pDS->fv(5).get_asInt();
+      p->m_iDuration = pDS->fv(10).get_asInt();
+      details.AddStream(p);
+      return true;
+    }
+  case CStreamDetail::AUDIO:
+    {
+      CStreamDetailAudio *p = new CStreamDetailAudio();
+      p->m_strCodec = pDS->fv(6).get_asString();
+      if (pDS->fv(7).get_isNull())
+        p->m_iChannels = -1;
+      else
+        p->m_iChannels = pDS->fv(7).get_asInt();
+      p->m_strLanguage = pDS->fv(8).get_asString();
+      details.AddStream(p);
+      return true;
+    }
+  case CStreamDetail::SUBTITLE:
+    {
+      CStreamDetailSubtitle *p = new CStreamDetailSubtitle();
+      p->m_strLanguage = pDS->fv(9).get_asString();
+      details.AddStream(p);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void FinishStreamDetails(CVideoInfoTag &tag)
+{
+  CStreamDetails& details = tag.m_streamDetails;
+  details.DetermineBestStreams();
+
+  if (details.GetVideoDuration() > 0)
+    tag.m_strRuntime.Format("%i", details.GetVideoDuration() / 60 );
+}
+
 bool CVideoDatabase::GetStreamDetails(CVideoInfoTag& tag) const
 {
   if (tag.m_iFileId < 0)
@@ -2755,57 +2804,66 @@ bool CVideoDatabase::GetStreamDetails(CVideoInfoTag& tag) const
   details.Reset();
   while (!pDS->eof())
   {
-    CStreamDetail::StreamType e = (CStreamDetail::StreamType)pDS->fv(1).get_asInt();
-    switch (e)
-    {
-    case CStreamDetail::VIDEO:
-      {
-        CStreamDetailVideo *p = new CStreamDetailVideo();
-        p->m_strCodec = pDS->fv(2).get_asString();
-        p->m_fAspect = pDS->fv(3).get_asFloat();
-        p->m_iWidth = pDS->fv(4).get_asInt();
-        p->m_iHeight = pDS->fv(5).get_asInt();
-        p->m_iDuration = pDS->fv(10).get_asInt();
-        details.AddStream(p);
-        retVal = true;
-        break;
-      }
-    case CStreamDetail::AUDIO:
-      {
-        CStreamDetailAudio *p = new CStreamDetailAudio();
-        p->m_strCodec = pDS->fv(6).get_asString();
-        if (pDS->fv(7).get_isNull())
-          p->m_iChannels = -1;
-        else
-          p->m_iChannels = pDS->fv(7).get_asInt();
-        p->m_strLanguage = pDS->fv(8).get_asString();
-        details.AddStream(p);
-        retVal = true;
-        break;
-      }
-    case CStreamDetail::SUBTITLE:
-      {
-        CStreamDetailSubtitle *p = new CStreamDetailSubtitle();
-        p->m_strLanguage = pDS->fv(9).get_asString();
-        details.AddStream(p);
-        retVal = true;
-        break;
-      }
-    }
-
+    if (AddStreamDetail(pDS, details))
+      retVal = true;
     pDS->next();
   }
 
   pDS->close();
-  details.DetermineBestStreams();
-
-  if (details.GetVideoDuration() > 0)
-    tag.m_strRuntime.Format("%i", details.GetVideoDuration() / 60 );
+  FinishStreamDetails(tag);
 
   return retVal;
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMovie(auto_ptr<Dataset> &pDS, bool needsCast /* = false */)
+#define STREAMDETAILS_FILES_PER_QUERY 500
+
+void CVideoDatabase::GetStreamDetails(CFileItemList &items, int start) const
+{
+  // one query per batch of files rather than one per item
+  map<int, vector<CVideoInfoTag*> > tags;
+  for (int i = start; i < items.Size(); i++)
+  {
+    if (!items[i]->HasVideoInfoTag())
+      continue;
+    CVideoInfoTag *tag = items[i]->GetVideoInfoTag();
+    tag->m_streamDetails.Reset();
+    if (tag->m_iFileId >= 0)
+      tags[tag->m_iFileId].push_back(tag);
+  }
+
+  auto_ptr<dbiplus::Dataset> pDS(m_pDB->CreateDataset());
+  map<int, vector<CVideoInfoTag*> >::const_iterator batch = tags.begin();
+  while (batch != tags.end())
+  {
+    CStdString files, file;
+    for (int count = 0; batch != tags.end() && count < STREAMDETAILS_FILES_PER_QUERY; ++batch, ++count)
+    {
+      file.Format(count ? ",%i" : "%i", batch->first);
+      files += file;
+    }
+
+    pDS->query("SELECT * FROM streamdetails WHERE idFile IN (" + files + ")");
+    while (!pDS->eof())
+    {
+      map<int, vector<CVideoInfoTag*> >::const_iterator it = tags.find(pDS->fv(0).get_asInt());
+      if (it != tags.end())
+      {
+        for (vector<CVideoInfoTag*>::const_iterator tag = it->second.begin(); tag != it->second.end(); ++tag)
+          AddStreamDetail(pDS.get(), (*tag)->m_streamDetails);
+      }
+      pDS->next();
+    }
+    pDS->close();
+  }
+
+  for (int i = start; i < items.Size(); i++)
+  {
+    if (items[i]->HasVideoInfoTag())
+      FinishStreamDetails(*items[i]->GetVideoInfoTag());
+  }
+}
+
+CVideoInfoTag CVideoDatabase::GetDetailsForMovie(auto_ptr<Dataset> &pDS, bool needsCast /* = false */, bool needsStreamDetails /* = true */)
 {
   CVideoInfoTag details;
   details.Reset();
@@ -2819,7 +2877,8 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMovie(auto_ptr<Dataset> &pDS, bool ne
   GetCommonDetails(pDS, details);
   movieTime += CTimeUtils::GetTimeMS() - time; time = CTimeUtils::GetTimeMS();
 
-  GetStreamDetails(details);
+  if (needsStreamDetails)
+    GetStreamDetails(details);
 
   if (needsCast)
   {
@@ -2907,7 +2966,7 @@ CVideoInfoTag CVideoDatabase::GetDetailsForTvShow(auto_ptr<Dataset> &pDS, bool n
   return details;
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(auto_ptr<Dataset> &pDS, bool needsCast /* = false */)
+CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(auto_ptr<Dataset> &pDS, bool needsCast /* = false */, bool needsStreamDetails /* = true */)
 {
   CVideoInfoTag details;
   details.Reset();
@@ -2925,7 +2984,8 @@ CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(auto_ptr<Dataset> &pDS, bool
   details.m_strStudio = pDS->fv(VIDEODB_DETAILS_EPISODE_TVSHOW_STUDIO).get_asString();
   details.m_strPremiered = pDS->fv(VIDEODB_DETAILS_EPISODE_TVSHOW_AIRED).get_asString();
 
-  GetStreamDetails(details);
+  if (needsStreamDetails)
+    GetStreamDetails(details);
 
   if (needsCast)
   {
@@ -2976,7 +3036,7 @@ CVideoInfoTag CVideoDatabase::GetDetailsForEpisode(auto_ptr<Dataset> &pDS, bool
   return details;
 }
 
-CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(auto_ptr<Dataset> &pDS)
+CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(auto_ptr<Dataset> &pDS, bool needsStreamDetails /* = true */)
 {
   CVideoInfoTag details;
   details.Reset();
@@ -2989,7 +3049,8 @@ CVideoInfoTag CVideoDatabase::GetDetailsForMusicVideo(auto_ptr<Dataset> &pDS)
   GetCommonDetails(pDS, details);
   movieTime += CTimeUtils::GetTimeMS() - time; time = CTimeUtils::GetTimeMS();
 
-  GetStreamDetails(details);
+  if (needsStreamDetails)
+    GetStreamDetails(details);
 
   details.m_strPictureURL.Parse();
   return details;
@@ -4700,10 +4761,11 @@ bool CVideoDatabase::GetMoviesByWhere(const CStdString& strBaseDir, const CStdSt
       return iRowsFound == 0;
 
     // get data from returned rows
-    items.Reserve(iRowsFound);
+    int start = items.Size();
+    items.Reserve(start + iRowsFound);
     while (!m_pDS->eof())
     {
-      CVideoInfoTag movie = GetDetailsForMovie(m_pDS);
+      CVideoInfoTag movie = GetDetailsForMovie(m_pDS, false, false);
       if (g_settings.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
           g_passwordManager.bMasterUser                                   ||
           g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, g_settings.m_videoSources))
@@ -4718,6 +4780,7 @@ bool CVideoDatabase::GetMoviesByWhere(const CStdString& strBaseDir, const CStdSt
 
     // cleanup
     m_pDS->close();
+    GetStreamDetails(items, start);
     return true;
   }
   catch (...)
@@ -5035,13 +5098,14 @@ bool CVideoDatabase::GetEpisodesByWhere(const CStdString& strBaseDir, const CStd
       return iRowsFound == 0;
 
     // get data from returned rows
-    items.Reserve(iRowsFound);
+    int start = items.Size();
+    items.Reserve(start + iRowsFound);
     while (!m_pDS->eof())
     {
       int idEpisode = m_pDS->fv("idEpisode").get_asInt();
       int idShow = m_pDS->fv("idShow").get_asInt();
 
-      CVideoInfoTag movie = GetDetailsForEpisode(m_pDS);
+      CVideoInfoTag movie = GetDetailsForEpisode(m_pDS, false, false);
       CFileItemPtr pItem(new CFileItem(movie));
       if (appendFullShowPath)
         pItem->m_strPath.Format("%s%ld/%ld/%ld",strBaseDir.c_str(), idShow, movie.m_iSeason,idEpisode);
@@ -5058,6 +5122,7 @@ bool CVideoDatabase::GetEpisodesByWhere(const CStdString& strBaseDir, const CStd
 
     // cleanup
     m_pDS->close();
+    GetStreamDetails(items, start);
     return true;
   }
   catch (...)
@@ -5839,12 +5904,13 @@ bool CVideoDatabase::GetMusicVideosByWhere(const CStdString &baseDir, const CStd
     }
 
     // get data from returned rows
-    items.Reserve(iRowsFound);
+    int start = items.Size();
+    items.Reserve(start + iRowsFound);
     // get songs from returned subtable
     while (!m_pDS->eof())
     {
       int idMVideo = m_pDS->fv("idMVideo").get_asInt();
-      CVideoInfoTag musicvideo = GetDetailsForMusicVideo(m_pDS);
+      CVideoInfoTag musicvideo = GetDetailsForMusicVideo(m_pDS, false);
       if (!checkLocks || g_settings.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE || g_passwordManager.bMasterUser ||
           g_passwordManager.IsDatabasePathUnlocked(musicvideo.m_strPath,g_settings.m_videoSources))
       {
@@ -5856,10 +5922,10 @@ bool CVideoDatabase::GetMusicVideosByWhere(const CStdString &baseDir, const CStd
       m_pDS->next();
     }
 
-    CLog::Log(LOGDEBUG, "%s time to retrieve from dataset = %d", __FUNCTION__, CTimeUtils::GetTimeMS() - time); time = CTimeUtils::GetTimeMS();
-
-    // cleanup
     m_pDS->close();
+    GetStreamDetails(items, start);
+
+    CLog::Log(LOGDEBUG, "%s time to retrieve from dataset = %d", __FUNCTION__, CTimeUtils::GetTimeMS() - time); time = CTimeUtils::GetTimeMS();
     return true;
   }
   catch (...)
@@ -123,6 +123,7 @@ namespace VIDEO
 
       tick = CTimeUtils::GetTimeMS() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      CRegExp::LogCacheStats();
 
       m_bRunning = false;
       if (m_pObserver)
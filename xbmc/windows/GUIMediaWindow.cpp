@@ -55,6 +55,7 @@
 #include "filesystem/FactoryFileDirectory.h"
 #include "utils/log.h"
 #include "utils/FileUtils.h"
+#include "utils/InternedString.h"
 #include "guilib/GUIEditControl.h"
 #include "dialogs/GUIDialogKeyboard.h"
 #ifdef HAS_PYTHON
@@ -639,6 +640,11 @@ bool CGUIMediaWindow::GetDirectory(const CStdString &strDirectory, CFileItemList
     if (!m_rootDir.GetDirectory(strDirectory, items))
       return false;
 
+    CLog::Log(LOGDEBUG,"  Fetched %i items in %u ms", items.Size(), CTimeUtils::GetTimeMS() - time);
+    // walks the whole pool, only worth it when someone reads the debug log
+    if (g_advancedSettings.m_logLevel >= LOG_LEVEL_DEBUG_FREEMEM)
+      CInternedString::LogStats();
+
     // took over a second, and not normally cached, so cache it
     if (time + 1000 < CTimeUtils::GetTimeMS() && items.CacheToDiscIfSlow())
       items.Save(GetID());